@@ -6,8 +6,10 @@
 #include "lpam/orchestrator/LocalPagesAndMergeOrchestrator.hpp"
 #include "on-demand/orchestration/OnDemandOrchestrator.hpp"
 #include "on-demand/orchestration/OnDemandSingleThreadOrchestrator.hpp"
+#include "radix/orchestration/RadixContiguousOrchestrator.hpp"
 #include "radix/orchestration/RadixOrchestrator.hpp"
 #include "radix/orchestration/RadixSelectiveOrchestrator.hpp"
+#include "radix/orchestration/RadixTwoPassOrchestrator.hpp"
 #include "smb/orchestration/SmbBatchedOrchestrator.hpp"
 #include "smb/orchestration/SmbLockFreeBatchedOrchestrator.hpp"
 #include "smb/orchestration/SmbLockFreeOrchestrator.hpp"
@@ -16,6 +18,9 @@
 #include "tuple-generator/BatchedTupleGenerator.hpp"
 #include "tuple-types/tuple-types.hpp"
 #include "util/get_tuple_num_scaling_value.hpp"
+#include "util/numa/NumaTopology.hpp"
+#include "util/peak_rss.hpp"
+#include "util/topology/ThreadPinning.hpp"
 
 constexpr unsigned SLEEP_TIME_MS = 500;
 
@@ -402,6 +407,356 @@ void benchmark_CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchest
     }
 }
 
+// node-loads/node-load-misses count the loads served by the local/a remote node, the PerfEvent constructor does not open them
+void add_numa_counters(PerfEvent &perf) {
+    if (perf.events.empty()) {
+        return;
+    }
+    const std::pair<const char *, uint64_t> counters[] = {{"node-loads", PERF_COUNT_HW_CACHE_RESULT_ACCESS}, {"node-load-misses", PERF_COUNT_HW_CACHE_RESULT_MISS}};
+    for (const auto &[name, result]: counters) {
+        perf.registerCounter(name, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_NODE | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16));
+        auto &event = perf.events.back();
+        event.fd = static_cast<int>(syscall(__NR_perf_event_open, &event.pe, 0, -1, -1, 0));
+        if (event.fd < 0) {
+            perf.events.pop_back();
+            perf.names.pop_back();
+        }
+    }
+}
+
+// pages allocated on a node other than the preferred one (numa_miss) or by a thread of another node (other_node)
+struct NumastatDelta {
+    uint64_t numa_miss = NumaTopology::read_numastat("numa_miss");
+    uint64_t other_node = NumaTopology::read_numastat("other_node");
+
+    void add_params(BenchmarkParameters &params) const {
+        params.setParam("J-numa_miss", NumaTopology::read_numastat("numa_miss") - numa_miss);
+        params.setParam("K-other_node", NumaTopology::read_numastat("other_node") - other_node);
+    }
+};
+
+template<typename T, unsigned... Partitions>
+void benchmark_NumaPlacement(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (const auto placement: {NumaPlacement::None, NumaPlacement::HomeNode, NumaPlacement::PerNode}) {
+            for (unsigned threads: {16, 32, 64, 128}) {
+                auto run_orchestrator = [&](const std::string &impl, auto &&orchestrator) {
+                    BenchmarkParameters params;
+                    setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                    params.setParam("H-Nodes", NumaTopology::get_num_nodes());
+                    params.setParam("I-Placement", get_numa_placement_name(placement));
+                    PerfEvent perf;
+                    add_numa_counters(perf);
+                    const NumastatDelta numastat;
+                    {
+                        PerfEventBlock e(perf, 1'000'000, params, placement == NumaPlacement::None && threads == 16 && impl.starts_with("Smb"));
+                        orchestrator.run();
+                        numastat.add_params(e.parameters);
+                    }
+                    auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                    check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                };
+                run_orchestrator("SmbBatchedOrchestrator          ", SmbBatchedOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, placement));
+                run_orchestrator("RadixOrchestrator               ", RadixOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, placement));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// repeated runs per placement, the spread between repetitions shows how much the scheduler's thread migration costs
+template<typename T, unsigned... Partitions>
+void benchmark_ThreadPlacement(const unsigned tuples_to_generate_base, const unsigned repetitions = 5) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (const auto placement: {ThreadPlacement::None, ThreadPlacement::Compact, ThreadPlacement::Scatter, ThreadPlacement::PhysicalCores, ThreadPlacement::PerL3}) {
+            for (unsigned threads: {48, 64, 128}) {
+                for (unsigned repetition = 0; repetition < repetitions; ++repetition) {
+                    auto run_orchestrator = [&](const std::string &impl, auto &&orchestrator) {
+                        BenchmarkParameters params;
+                        setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                        params.setParam("H-Placement", get_thread_placement_name(placement));
+                        params.setParam("I-Repetition", repetition);
+                        PerfEvent perf;
+                        {
+                            PerfEventBlock e(perf, 1'000'000, params, placement == ThreadPlacement::None && threads == 48 && repetition == 0 && impl.starts_with("Smb"));
+                            orchestrator.run();
+                        }
+                        auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                        check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    };
+                    run_orchestrator("SmbBatchedOrchestrator          ", SmbBatchedOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, NumaPlacement::None, placement));
+                    run_orchestrator("RadixOrchestrator               ", RadixOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, NumaPlacement::None, placement));
+                    run_orchestrator("HybridOrchestrator              ", HybridOrchestrator<T, partition>(GeneratedRelation<T, 10 * 2048>(tuples_to_generate, {}), threads, placement));
+                    run_orchestrator("CmpThreadPoolOrchestratorProUnit", CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator<T, partition>(GeneratedRelation<T, 10 * 2048>(tuples_to_generate, {}), threads, placement));
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// static split vs. work stealing, reports the median and tail of the completion time over the repetitions since one
+// straggling thread delays the whole shuffle; 160 threads oversubscribe the machine to provoke preempted threads
+template<typename T, unsigned... Partitions>
+void benchmark_MorselDispatch(const unsigned tuples_to_generate_base, const unsigned repetitions = 20) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (const auto dispatch: {MorselDispatch::Static, MorselDispatch::WorkStealing}) {
+            for (unsigned threads: {64, 128, 160}) {
+                auto run_orchestrator = [&](const std::string &impl, auto &&create_orchestrator) {
+                    std::vector<double> completion_times_ms;
+                    for (unsigned repetition = 0; repetition < repetitions; ++repetition) {
+                        BenchmarkParameters params;
+                        setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                        params.setParam("H-Dispatch", get_morsel_dispatch_name(dispatch));
+                        params.setParam("I-Repetition", repetition);
+                        auto orchestrator = create_orchestrator();
+                        PerfEvent perf;
+                        {
+                            PerfEventBlock e(perf, 1'000'000, params, dispatch == MorselDispatch::Static && threads == 64 && repetition == 0 && impl.starts_with("SmbB"));
+                            const auto start = std::chrono::steady_clock::now();
+                            orchestrator.run();
+                            completion_times_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                        }
+                        auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                        check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    }
+                    std::ranges::sort(completion_times_ms);
+                    const auto percentile = [&](const double p) { return completion_times_ms[static_cast<size_t>(p * static_cast<double>(completion_times_ms.size() - 1))]; };
+                    std::cout << "completion time [ms] " << impl << " " << get_morsel_dispatch_name(dispatch) << " partitions=" << partition << " threads=" << threads
+                              << " p50=" << percentile(0.5) << " p95=" << percentile(0.95) << " max=" << completion_times_ms.back() << std::endl;
+                };
+                run_orchestrator("SmbBatchedOrchestrator          ", [&] { return SmbBatchedOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, NumaPlacement::None, ThreadPinning::get_default_placement(), dispatch); });
+                run_orchestrator("SmbOrchestrator                 ", [&] { return SmbOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, ThreadPinning::get_default_placement(), dispatch); });
+                run_orchestrator("OnDemandOrchestrator            ", [&] { return OnDemandOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, ThreadPinning::get_default_placement(), dispatch); });
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// regular vs. non-temporal streaming page writes. With 4096 partitions the per-partition buffers of SMB and radix
+// hold at least one tuple only up to 32 threads.
+template<typename T, unsigned... Partitions>
+void benchmark_PageStore(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (const auto store: {PageStore::Regular, PageStore::Streaming}) {
+            StreamingPageWriter::set_store(store);
+            for (unsigned threads: {16, 32}) {
+                auto run_orchestrator = [&](const std::string &impl, auto &&orchestrator) {
+                    BenchmarkParameters params;
+                    setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                    params.setParam("H-Page store", get_page_store_name(store));
+                    PerfEvent perf;
+                    {
+                        PerfEventBlock e(perf, 1'000'000, params, store == PageStore::Regular && threads == 16 && impl.starts_with("SmbB"));
+                        orchestrator.run();
+                    }
+                    auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                    check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                };
+                run_orchestrator("SmbBatchedOrchestrator          ", SmbBatchedOrchestrator<T, partition>(tuples_to_generate, threads));
+                run_orchestrator("SmbLockFreeBatchedOrchestrator  ", SmbLockFreeBatchedOrchestrator<T, partition>(tuples_to_generate, threads));
+                run_orchestrator("RadixOrchestrator               ", RadixOrchestrator<T, partition>(tuples_to_generate, threads));
+                run_orchestrator("HybridOrchestrator              ", HybridOrchestrator<T, partition>(tuples_to_generate, threads));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+        StreamingPageWriter::set_store(PageStore::Regular);
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// single pass against two pass radix partitioning, the single pass only runs while its buffer still holds a tuple per
+// partition, i.e. not for 16k partitions
+template<typename T, unsigned... Partitions>
+void benchmark_RadixTwoPass(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (unsigned threads: {16, 32}) {
+            auto run_orchestrator = [&](const std::string &impl, auto &&orchestrator) {
+                BenchmarkParameters params;
+                setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                PerfEvent perf;
+                {
+                    PerfEventBlock e(perf, 1'000'000, params, threads == 16 && impl.starts_with("RadixTwoPass"));
+                    orchestrator.run();
+                }
+                auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+            };
+            run_orchestrator("RadixTwoPassOrchestrator        ", RadixTwoPassOrchestrator<T, partition>(tuples_to_generate, threads));
+            if (2 * 1024 * 1024 / (sizeof(T) * threads) / partition > 0) {
+                run_orchestrator("RadixOrchestrator               ", RadixOrchestrator<T, partition>(tuples_to_generate, threads));
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// page ranges of the radix orchestrators from per-partition locks against a barrier and a parallel prefix sum
+template<typename T, unsigned... Partitions>
+void benchmark_HistogramMerge(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (const auto merge: {HistogramMerge::Locking, HistogramMerge::Barrier}) {
+            for (unsigned threads: {32, 64, 128}) {
+                auto run_orchestrator = [&](const std::string &impl, auto &&orchestrator) {
+                    BenchmarkParameters params;
+                    setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                    params.setParam("H-Histogram merge", get_histogram_merge_name(merge));
+                    PerfEvent perf;
+                    {
+                        PerfEventBlock e(perf, 1'000'000, params, merge == HistogramMerge::Locking && threads == 32 && impl.starts_with("RadixTwoPass"));
+                        orchestrator.run();
+                    }
+                    auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                    check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                };
+                const auto placement = ThreadPinning::get_default_placement();
+                run_orchestrator("RadixTwoPassOrchestrator        ", RadixTwoPassOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, NumaPlacement::None, placement, merge));
+                if (2 * 1024 * 1024 / (sizeof(T) * threads) / partition > 0) {
+                    run_orchestrator("RadixOrchestrator               ", RadixOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, NumaPlacement::None, placement, merge));
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// radix partitioning into slotted pages against exactly sized arrays per partition in row and PAX layout
+template<typename T, unsigned... Partitions>
+void benchmark_ContiguousOutput(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (unsigned threads: {16, 32}) {
+            auto run_orchestrator = [&](const std::string &impl, const char *layout, auto &&orchestrator) {
+                BenchmarkParameters params;
+                setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                params.setParam("H-Output layout", layout);
+                PerfEvent perf;
+                {
+                    PerfEventBlock e(perf, 1'000'000, params, threads == 16 && impl.starts_with("RadixOrchestrator"));
+                    orchestrator.run();
+                }
+                auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+            };
+            run_orchestrator("RadixOrchestrator               ", "slotted-pages", RadixOrchestrator<T, partition>(tuples_to_generate, threads));
+            for (const auto layout: {PartitionLayout::Row, PartitionLayout::Pax}) {
+                run_orchestrator("RadixContiguousOrchestrator     ", get_partition_layout_name(layout), RadixContiguousOrchestrator<T, partition>(GeneratedRelation<T>(tuples_to_generate, {}), threads, layout));
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// peak memory and runtime of the pipelined RadixOrchestrator against the two pass radix, which still materializes the
+// whole input first, at 1 GiB and 10 GiB of input
+template<typename T, unsigned... Partitions>
+void benchmark_RadixInputSize() {
+    auto run_benchmark = [&](auto partition) {
+        for (const size_t input_bytes: {size_t{1} << 30, size_t{10} << 30}) {
+            const auto tuples_to_generate = static_cast<unsigned>(input_bytes / sizeof(T));
+            for (unsigned threads: {32, 64}) {
+                auto run_orchestrator = [&](const std::string &impl, auto &&orchestrator) {
+                    BenchmarkParameters params;
+                    setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                    params.setParam("H-Input [MB]", input_bytes / (1024 * 1024));
+                    PerfEvent perf;
+                    reset_peak_rss();
+                    {
+                        PerfEventBlock e(perf, 1'000'000, params, input_bytes == size_t{1} << 30 && threads == 32 && impl.starts_with("RadixOrchestrator"));
+                        orchestrator.run();
+                        e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
+                    }
+                    auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                    check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                };
+                run_orchestrator("RadixOrchestrator               ", RadixOrchestrator<T, partition>(tuples_to_generate, threads));
+                run_orchestrator("RadixTwoPassOrchestrator        ", RadixTwoPassOrchestrator<T, partition>(tuples_to_generate, threads));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// the CMP thread pools with more than 32 workers, the thread pool orchestrator uses at most one worker per partition
+// so only 1024 partitions exercise it
+template<typename T, unsigned... Partitions>
+void benchmark_CmpManyThreads(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (unsigned threads: {32, 64, 128, 256}) {
+            auto run_orchestrator = [&](const std::string &impl, auto &&orchestrator) {
+                BenchmarkParameters params;
+                setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                PerfEvent perf;
+                {
+                    PerfEventBlock e(perf, 1'000'000, params, threads == 32 && impl.starts_with("CmpThreadPoolOrchestrator "));
+                    orchestrator.run();
+                }
+                auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+            };
+            run_orchestrator("CmpThreadPoolOrchestrator       ", CollaborativeMorselProcessingThreadPoolOrchestrator<T, partition>(tuples_to_generate, threads));
+            run_orchestrator("CmpThreadPoolOrchestratorProUnit", CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator<T, partition>(tuples_to_generate, threads));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+// runs the CMP thread pools with more threads than hardware threads and reports the CPU time they burn, i.e. how
+// much a waiting worker takes away from the threads that have work
+template<typename T, unsigned... Partitions>
+void benchmark_Oversubscription(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    const auto hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    const auto get_process_cpu_seconds = [] {
+        timespec time{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1e9;
+    };
+    auto run_benchmark = [&](auto partition) {
+        for (const unsigned oversubscription: {1, 2, 4}) {
+            const unsigned threads = hardware_threads * oversubscription;
+            auto run_orchestrator = [&](const std::string &impl, auto &&orchestrator) {
+                BenchmarkParameters params;
+                setup_benchmark_params<T>(params, impl, tuples_to_generate, partition, threads);
+                params.setParam("H-Oversubscription", oversubscription);
+                PerfEvent perf;
+                double cpu_seconds;
+                {
+                    PerfEventBlock e(perf, 1'000'000, params, oversubscription == 1 && impl.starts_with("CmpThreadPoolOrchestrator "));
+                    const auto cpu_seconds_before = get_process_cpu_seconds();
+                    orchestrator.run();
+                    cpu_seconds = get_process_cpu_seconds() - cpu_seconds_before;
+                }
+                auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                std::cout << "cpu efficiency " << impl << " partitions=" << partition << " threads=" << threads << " cpu-seconds=" << cpu_seconds
+                          << " tuples-per-cpu-second=" << static_cast<double>(tuples_to_generate) / cpu_seconds << std::endl;
+            };
+            run_orchestrator("CmpThreadPoolOrchestrator       ", CollaborativeMorselProcessingThreadPoolOrchestrator<T, partition>(tuples_to_generate, threads));
+            run_orchestrator("CmpThreadPoolOrchestratorProUnit", CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator<T, partition>(tuples_to_generate, threads));
+            run_orchestrator("SmbBatchedOrchestrator          ", SmbBatchedOrchestrator<T, partition>(tuples_to_generate, threads));
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
 template<typename T>
 void warmup_run(const unsigned tuples_to_generate_base) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
@@ -641,6 +996,24 @@ void benchmark_synchronised_write_out(const std::chrono::milliseconds time_to_wr
 int main() {
     constexpr unsigned tuples_to_generate_base = 5 * 40'000'000u;
 
+    // remote node accesses of first-touch placement vs. home nodes vs. node-local page chains per partition
+    benchmark_NumaPlacement<Tuple16, 32, 1024>(tuples_to_generate_base);
+    benchmark_NumaPlacement<Tuple100, 32, 1024>(tuples_to_generate_base);
+
+    // run-to-run variance of unpinned threads vs. the pinning policies at 48+ threads
+    benchmark_ThreadPlacement<Tuple16, 32, 1024>(tuples_to_generate_base);
+
+    // tail completion time of the static split vs. work-stealing morsel dispatch
+    benchmark_MorselDispatch<Tuple16, 32, 1024>(tuples_to_generate_base);
+    benchmark_Oversubscription<Tuple16, 32, 1024>(tuples_to_generate_base);
+    benchmark_CmpManyThreads<Tuple16, 1024>(tuples_to_generate_base);
+    benchmark_PageStore<Tuple16, 32, 1024, 4096>(tuples_to_generate_base);
+    benchmark_RadixTwoPass<Tuple16, 512, 1024, 4096, 16384>(tuples_to_generate_base);
+    benchmark_HistogramMerge<Tuple16, 1024, 4096>(tuples_to_generate_base);
+    benchmark_ContiguousOutput<Tuple16, 32, 1024>(tuples_to_generate_base);
+    benchmark_ContiguousOutput<Tuple100, 32, 1024>(tuples_to_generate_base);
+    benchmark_RadixInputSize<Tuple16, 1024>();
+
     run_benchmark_on_all_implementations<Tuple4, 4>(tuples_to_generate_base);
     run_benchmark_on_all_implementations<Tuple16, 4>(tuples_to_generate_base);
     run_benchmark_on_all_implementations<Tuple100, 4>(tuples_to_generate_base);
@@ -138,6 +138,82 @@ void benchmark_simd(size_t tuples_to_generate) {
 }
 
 
+template<typename T, size_t partitions, typename PartitionHash = IdentityHash>
+void benchmark_batch(size_t tuples_to_generate) {
+    BatchedTupleGenerator<T> generator(tuples_to_generate, SEED);
+    std::array<unsigned, partitions> buffer_count = {};
+    std::unique_ptr<uint16_t[]> partition_ids = std::make_unique<uint16_t[]>(BatchedTupleGenerator<T>::getBatchSize());
+
+    while (true) {
+        const auto [ptr, size_of_batch] = generator.getBatchOfTuples();
+        if (ptr == nullptr) {
+            break;
+        }
+        partition_function_batch<T, partitions, PartitionHash>(ptr.get(), size_of_batch, partition_ids.get());
+        for (size_t i = 0; i < size_of_batch; i++) {
+            ++buffer_count[partition_ids[i]];
+        }
+    }
+    size_t actual_tuples = 0;
+    for (auto tuples: buffer_count) {
+        actual_tuples += tuples;
+    }
+    if (actual_tuples != tuples_to_generate) {
+        std::cerr << "Error: Seen tuples does not match tuples to generate\n";
+    }
+}
+
+
+template<typename T, size_t partitions>
+void benchmark_runtime_modulo(size_t tuples_to_generate) {
+    BatchedTupleGenerator<T> generator(tuples_to_generate, SEED);
+    std::array<unsigned, partitions> buffer_count = {};
+    // volatile keeps the compiler from strength-reducing the division by a known constant
+    volatile uint32_t runtime_partitions = partitions;
+    const uint32_t divisor = runtime_partitions;
+
+    while (true) {
+        const auto [ptr, size_of_batch] = generator.getBatchOfTuples();
+        if (ptr == nullptr) {
+            break;
+        }
+        for (size_t i = 0; i < size_of_batch; i++) {
+            ++buffer_count[ptr[i].get_key() % divisor];
+        }
+    }
+    size_t actual_tuples = 0;
+    for (auto tuples: buffer_count) {
+        actual_tuples += tuples;
+    }
+    if (actual_tuples != tuples_to_generate) {
+        std::cerr << "Error: Seen tuples does not match tuples to generate\n";
+    }
+}
+
+template<typename T, size_t partitions>
+void benchmark_runtime_fast_modulo(size_t tuples_to_generate) {
+    BatchedTupleGenerator<T> generator(tuples_to_generate, SEED);
+    std::array<unsigned, partitions> buffer_count = {};
+    volatile uint32_t runtime_partitions = partitions;
+    const FastModulo fast_modulo(runtime_partitions);
+
+    while (true) {
+        const auto [ptr, size_of_batch] = generator.getBatchOfTuples();
+        if (ptr == nullptr) {
+            break;
+        }
+        for (size_t i = 0; i < size_of_batch; i++) {
+            ++buffer_count[fast_modulo(ptr[i].get_key())];
+        }
+    }
+    size_t actual_tuples = 0;
+    for (auto tuples: buffer_count) {
+        actual_tuples += tuples;
+    }
+    if (actual_tuples != tuples_to_generate) {
+        std::cerr << "Error: Seen tuples does not match tuples to generate\n";
+    }
+}
 
 template<typename T, size_t partitions>
 void run_benchmarks(BenchmarkParameters &params, size_t tuples_to_generate_base) {
@@ -168,6 +244,36 @@ void run_benchmarks(BenchmarkParameters &params, size_t tuples_to_generate_base)
         PerfEventBlock e(100'000, params, false);
         benchmark_simd<T, partitions>(tuples_to_generate);
     }
+    params.setParam("A-Benchmark partition", "batch");
+    {
+        PerfEventBlock e(100'000, params, false);
+        benchmark_batch<T, partitions>(tuples_to_generate);
+    }
+    params.setParam("A-Benchmark partition", "batch_crc32");
+    {
+        PerfEventBlock e(100'000, params, false);
+        benchmark_batch<T, partitions, Crc32Hash>(tuples_to_generate);
+    }
+    params.setParam("A-Benchmark partition", "batch_fibonacci");
+    {
+        PerfEventBlock e(100'000, params, false);
+        benchmark_batch<T, partitions, FibonacciHash>(tuples_to_generate);
+    }
+    params.setParam("A-Benchmark partition", "batch_murmur");
+    {
+        PerfEventBlock e(100'000, params, false);
+        benchmark_batch<T, partitions, MurmurHash>(tuples_to_generate);
+    }
+    params.setParam("A-Benchmark partition", "runtime_modulo");
+    {
+        PerfEventBlock e(100'000, params, false);
+        benchmark_runtime_modulo<T, partitions>(tuples_to_generate);
+    }
+    params.setParam("A-Benchmark partition", "runtime_fast_modulo");
+    {
+        PerfEventBlock e(100'000, params, false);
+        benchmark_runtime_fast_modulo<T, partitions>(tuples_to_generate);
+    }
 
 }
 
@@ -183,6 +289,17 @@ int main() {
 
         run_benchmarks<Tuple4, 32>(params, tuples_to_generate_base);
         run_benchmarks<Tuple4, 1024>(params, tuples_to_generate_base);
+
+        // non-power-of-two partition counts use the fast modulo path instead of masking
+        run_benchmarks<Tuple16, 24>(params, tuples_to_generate_base);
+        run_benchmarks<Tuple16, 48>(params, tuples_to_generate_base);
+        run_benchmarks<Tuple16, 96>(params, tuples_to_generate_base);
+
+        run_benchmarks<Tuple100, 24>(params, tuples_to_generate_base);
+        run_benchmarks<Tuple100, 96>(params, tuples_to_generate_base);
+
+        run_benchmarks<Tuple4, 24>(params, tuples_to_generate_base);
+        run_benchmarks<Tuple4, 96>(params, tuples_to_generate_base);
     }
     return 0;
 }
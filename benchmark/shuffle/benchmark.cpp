@@ -6,6 +6,8 @@
 #include "lpam/orchestrator/LocalPagesAndMergeOrchestrator.hpp"
 #include "on-demand/orchestration/OnDemandOrchestrator.hpp"
 #include "on-demand/orchestration/OnDemandSingleThreadOrchestrator.hpp"
+#include "shuffle-operator/AdaptiveShuffleOrchestrator.hpp"
+#include "shuffle-operator/ShuffleOperator.hpp"
 #include "radix/orchestration/RadixOrchestrator.hpp"
 #include "radix/orchestration/RadixSelectiveOrchestrator.hpp"
 #include "smb/orchestration/SmbBatchedOrchestrator.hpp"
@@ -15,7 +17,11 @@
 #include "smb/orchestration/SmbSingleThreadOrchestrator.hpp"
 #include "tuple-generator/BatchedTupleGenerator.hpp"
 #include "tuple-types/tuple-types.hpp"
+#include "slotted-page/page-memory/PageMemory.hpp"
+#include "slotted-page/page-pool/SlottedPagePool.hpp"
 #include "util/get_tuple_num_scaling_value.hpp"
+#include "util/peak_rss.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
 constexpr unsigned SLEEP_TIME_MS = 500;
 
@@ -32,7 +38,7 @@ void check_sum_of_written_tuples(size_t tuples_to_generate, std::vector<size_t>
 }
 
 template<typename T>
-void setup_benchmark_params(BenchmarkParameters &params, const std::string &impl, size_t tuples_to_generate, size_t partition, size_t threads) {
+void setup_benchmark_params(BenchmarkParameters &params, const std::string &impl, size_t tuples_to_generate, size_t partition, size_t threads, const KeyDistribution &key_distribution) {
     params.setParam("A-Benchmark shuffle", impl);
     params.setParam("B-tuple_size", sizeof(T));
     params.setParam("C-Tuples", tuples_to_generate);
@@ -42,25 +48,28 @@ void setup_benchmark_params(BenchmarkParameters &params, const std::string &impl
     params.setParam("D-GB", gb_str.str());
     params.setParam("E-Partitions", partition);
     params.setParam("F-Threads", threads);
+    params.setParam("G-Key distribution", key_distribution.get_name());
 }
 
 
 template<typename T, unsigned... Partitions>
-void benchmark_RadixOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_RadixOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "RadixOrchestrator               ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "RadixOrchestrator               ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    RadixOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    RadixOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -73,24 +82,26 @@ void benchmark_RadixOrchestrator(const unsigned tuples_to_generate_base) {
 }
 
 template<typename T, unsigned... Partitions>
-void benchmark_RadixSelectiveOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_RadixSelectiveOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "RadixSelectiveOrchestrator      ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "RadixSelectiveOrchestrator      ", tuples_to_generate, partition, threads, key_distribution);
                 constexpr unsigned k = 32;
-                params.setParam("G-k", k);
+                params.setParam("H-k", k);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    RadixSelectiveOrchestrator<T, partition, 5 * 1024 * 1024, k> orchestrator(tuples_to_generate, threads);
+                    RadixSelectiveOrchestrator<T, partition, 5 * 1024 * 1024, k> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -105,22 +116,24 @@ void benchmark_RadixSelectiveOrchestrator(const unsigned tuples_to_generate_base
 }
 
 template<typename T, unsigned... Partitions>
-void benchmark_SmbOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_SmbOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "SmbOrchestrator                 ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "SmbOrchestrator                 ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    SmbOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    SmbOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -134,22 +147,24 @@ void benchmark_SmbOrchestrator(const unsigned tuples_to_generate_base) {
     }
 }
 template<typename T, unsigned... Partitions>
-void benchmark_SmbLockFreeOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_SmbLockFreeOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "SmbLockFreeOrchestrator         ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "SmbLockFreeOrchestrator         ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    SmbLockFreeOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    SmbLockFreeOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -163,22 +178,24 @@ void benchmark_SmbLockFreeOrchestrator(const unsigned tuples_to_generate_base) {
     }
 }
 template<typename T, unsigned... Partitions>
-void benchmark_SmbLockFreeBatchedOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_SmbLockFreeBatchedOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "SmbLockFreeBatchedOrchestrator  ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "SmbLockFreeBatchedOrchestrator  ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    SmbLockFreeBatchedOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    SmbLockFreeBatchedOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -192,22 +209,24 @@ void benchmark_SmbLockFreeBatchedOrchestrator(const unsigned tuples_to_generate_
     }
 }
 template<typename T, unsigned... Partitions>
-void benchmark_SmbSingleThreadOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_SmbSingleThreadOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             unsigned threads = 1;
             BenchmarkParameters params;
-            setup_benchmark_params<T>(params, "SmbSingleThreadOrchestrator     ", tuples_to_generate, partition, threads);
+            setup_benchmark_params<T>(params, "SmbSingleThreadOrchestrator     ", tuples_to_generate, partition, threads, key_distribution);
             {
+                reset_peak_rss();
                 PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                SmbSingleThreadOrchestrator<T, partition> orchestrator(tuples_to_generate);
+                SmbSingleThreadOrchestrator<T, partition> orchestrator(tuples_to_generate, key_distribution);
                 orchestrator.run();
 
                 // Verify the result
                 auto written_tuples = orchestrator.get_written_tuples_per_partition();
                 check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
             }
             if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                 threads = 5;
@@ -221,22 +240,24 @@ void benchmark_SmbSingleThreadOrchestrator(const unsigned tuples_to_generate_bas
     }
 }
 template<typename T, unsigned... Partitions>
-void benchmark_SmbBatchedOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_SmbBatchedOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "SmbBatchedOrchestrator          ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "SmbBatchedOrchestrator          ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    SmbBatchedOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    SmbBatchedOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -251,22 +272,93 @@ void benchmark_SmbBatchedOrchestrator(const unsigned tuples_to_generate_base) {
 }
 
 template<typename T, unsigned... Partitions>
-void benchmark_OnDemandOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_ShuffleOperatorRuntimePath(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "OnDemandOrchestrator            ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "ShuffleOperator (runtime path)  ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    OnDemandOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    const ShuffleOperator shuffle_operator({.algorithm = ShuffleAlgorithm::Smb,
+                                                            .tuple_layout = get_tuple_layout<T>(),
+                                                            .partitions = partition,
+                                                            .num_threads = threads,
+                                                            .force_runtime_path = true,
+                                                            .key_distribution = key_distribution});
+                    auto written_tuples = shuffle_operator.run(tuples_to_generate);
+
+                    // Verify the result
+                    check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
+                }
+                if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
+                    threads = 5;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        };
+
+        // Use fold expression to call run_benchmark with each partition value
+        (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+    }
+}
+
+// The input is split into micro-batches, the algorithm every batch ran with is recorded next to its counters.
+template<typename T, unsigned... Partitions>
+void benchmark_AdaptiveShuffleOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
+    constexpr unsigned micro_batches = 10;
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    const unsigned tuples_per_batch = tuples_to_generate / micro_batches;
+    auto run_benchmark = [&](auto partition) {
+        for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
+            AdaptiveShuffleOrchestrator orchestrator({.tuple_layout = get_tuple_layout<T>(), .partitions = partition, .num_threads = threads, .key_distribution = key_distribution});
+            for (unsigned batch = 0; batch < micro_batches; ++batch) {
+                BenchmarkParameters params;
+                setup_benchmark_params<T>(params, "AdaptiveShuffleOrchestrator     ", tuples_per_batch, partition, threads, key_distribution);
+                params.setParam("H-Batch", batch);
+                {
+                    PerfEventBlock e(1'000'000, params, threads == 1 && batch == 0);
+                    auto written_tuples = orchestrator.run(tuples_per_batch);
+
+                    // Verify the result
+                    check_sum_of_written_tuples(tuples_per_batch, written_tuples);
+                    e.parameters.setParam("I-Algorithm", get_shuffle_algorithm_name(orchestrator.get_last_algorithm()));
+                }
+            }
+            if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
+                threads = 5;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+    };
+
+    // Use fold expression to call run_benchmark with each partition value
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+}
+
+template<typename T, unsigned... Partitions>
+void benchmark_OnDemandOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
+    auto tuple_count_factor = get_tuple_num_scaling_value<T>();
+    for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
+        auto run_benchmark = [&](auto partition) {
+            for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
+                BenchmarkParameters params;
+                setup_benchmark_params<T>(params, "OnDemandOrchestrator            ", tuples_to_generate, partition, threads, key_distribution);
+                {
+                    reset_peak_rss();
+                    PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
+
+                    OnDemandOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -281,22 +373,24 @@ void benchmark_OnDemandOrchestrator(const unsigned tuples_to_generate_base) {
 }
 
 template<typename T, unsigned... Partitions>
-void benchmark_OnDemandSingleThreadOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_OnDemandSingleThreadOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             unsigned threads = 1;
             BenchmarkParameters params;
-            setup_benchmark_params<T>(params, "OnDemandSingleThreadOrchestrator", tuples_to_generate, partition, threads);
+            setup_benchmark_params<T>(params, "OnDemandSingleThreadOrchestrator", tuples_to_generate, partition, threads, key_distribution);
             {
+                reset_peak_rss();
                 PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                OnDemandSingleThreadOrchestrator<T, partition> orchestrator(tuples_to_generate);
+                OnDemandSingleThreadOrchestrator<T, partition> orchestrator(tuples_to_generate, key_distribution);
                 orchestrator.run();
 
                 // Verify the result
                 auto written_tuples = orchestrator.get_written_tuples_per_partition();
                 check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
             }
             if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                 threads = 5;
@@ -309,22 +403,24 @@ void benchmark_OnDemandSingleThreadOrchestrator(const unsigned tuples_to_generat
 }
 
 template<typename T, unsigned... Partitions>
-void benchmark_HybridOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_HybridOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "HybridOrchestrator              ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "HybridOrchestrator              ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    HybridOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    HybridOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -339,22 +435,24 @@ void benchmark_HybridOrchestrator(const unsigned tuples_to_generate_base) {
 }
 
 template<typename T, unsigned... Partitions>
-void benchmark_LocalPagesAndMergeOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_LocalPagesAndMergeOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "LocalPagesAndMergeOrchestrator  ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "LocalPagesAndMergeOrchestrator  ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    LocalPagesAndMergeOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    LocalPagesAndMergeOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -368,22 +466,24 @@ void benchmark_LocalPagesAndMergeOrchestrator(const unsigned tuples_to_generate_
     }
 }
 template<typename T, unsigned... Partitions>
-void benchmark_CollaborativeMorselProcessingOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_CollaborativeMorselProcessingOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "CmpOrchestrator                 ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "CmpOrchestrator                 ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 1);
 
-                    CollaborativeMorselProcessingOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    CollaborativeMorselProcessingOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -398,22 +498,24 @@ void benchmark_CollaborativeMorselProcessingOrchestrator(const unsigned tuples_t
 }
 
 template<typename T, unsigned... Partitions>
-void benchmark_CollaborativeMorselProcessingThreadPoolOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_CollaborativeMorselProcessingThreadPoolOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 2; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "CmpThreadPoolOrchestrator       ", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "CmpThreadPoolOrchestrator       ", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 2);
 
-                    CollaborativeMorselProcessingThreadPoolOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    CollaborativeMorselProcessingThreadPoolOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -427,22 +529,24 @@ void benchmark_CollaborativeMorselProcessingThreadPoolOrchestrator(const unsigne
     }
 }
 template<typename T, unsigned... Partitions>
-void benchmark_CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator(const unsigned tuples_to_generate_base) {
+void benchmark_CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
     for (auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate <= 1 * static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor); tuples_to_generate += static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor)) {
         auto run_benchmark = [&](auto partition) {
             for (unsigned threads = 2; threads <= std::thread::hardware_concurrency(); threads *= 2) {
                 BenchmarkParameters params;
-                setup_benchmark_params<T>(params, "CmpThreadPoolOrchestratorProUnit", tuples_to_generate, partition, threads);
+                setup_benchmark_params<T>(params, "CmpThreadPoolOrchestratorProUnit", tuples_to_generate, partition, threads, key_distribution);
                 {
+                    reset_peak_rss();
                     PerfEventBlock e(1'000'000, params, tuples_to_generate == static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * tuple_count_factor) && threads == 2);
 
-                    CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator<T, partition> orchestrator(tuples_to_generate, threads, key_distribution);
                     orchestrator.run();
 
                     // Verify the result
                     auto written_tuples = orchestrator.get_written_tuples_per_partition();
                     check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                    e.parameters.setParam("H-Peak RSS [MB]", get_peak_rss_bytes() / (1024 * 1024));
                 }
                 if (threads == 8 && std::thread::hardware_concurrency() >= 20) {
                     threads = 5;
@@ -456,6 +560,173 @@ void benchmark_CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchest
     }
 }
 
+// the PerfEvent constructor only opens its default counters, so the dTLB counters are opened here
+void add_dtlb_counters(PerfEvent &perf) {
+    if (perf.events.empty()) {
+        return;
+    }
+    const std::pair<const char *, uint64_t> counters[] = {{"dTLB-load-misses", PERF_COUNT_HW_CACHE_OP_READ}, {"dTLB-store-misses", PERF_COUNT_HW_CACHE_OP_WRITE}};
+    for (const auto &[name, operation]: counters) {
+        perf.registerCounter(name, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (operation << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        auto &event = perf.events.back();
+        event.fd = static_cast<int>(syscall(__NR_perf_event_open, &event.pe, 0, -1, -1, 0));
+        if (event.fd < 0) {
+            perf.events.pop_back();
+            perf.names.pop_back();
+        }
+    }
+}
+
+template<typename T, unsigned... Partitions>
+void benchmark_PageAllocation(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    const PageAllocationPolicy policies[] = {
+            {PageAllocation::Zeroed, false},
+            {PageAllocation::Uninitialized, false},
+            {PageAllocation::Uninitialized, true},
+            {PageAllocation::TransparentHugePages, false},
+            {PageAllocation::TransparentHugePages, true},
+            {PageAllocation::HugeTlb2M, true},
+    };
+    auto run_benchmark = [&](auto partition) {
+        for (const auto &policy: policies) {
+            PageAllocator::set_policy(policy);
+            const unsigned threads = std::thread::hardware_concurrency();
+            BenchmarkParameters params;
+            setup_benchmark_params<T>(params, "SmbBatchedOrchestrator          ", tuples_to_generate, partition, threads, KeyDistribution::uniform());
+            params.setParam("H-Page allocation", policy.get_name());
+            {
+                PerfEvent perf;
+                add_dtlb_counters(perf);
+                PerfEventBlock e(perf, 1'000'000, params, policy.allocation == PageAllocation::Zeroed);
+
+                SmbBatchedOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                orchestrator.run();
+
+                auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+            }
+            // pooled pages were allocated with the previous policy
+            SlottedPagePool::trim();
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+    PageAllocator::set_policy({});
+}
+
+// repeated shuffles, once drawing the pages from the warm page pool and once from a trimmed pool (fresh allocations)
+template<typename T, unsigned... Partitions>
+void benchmark_PagePoolReuse(const unsigned tuples_to_generate_base, const unsigned repetitions = 5) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](auto partition) {
+        for (const bool warm_pool: {false, true}) {
+            SlottedPagePool::trim();
+            for (unsigned repetition = 0; repetition < repetitions; ++repetition) {
+                if (!warm_pool) {
+                    SlottedPagePool::trim();
+                }
+                const unsigned threads = std::thread::hardware_concurrency();
+                BenchmarkParameters params;
+                setup_benchmark_params<T>(params, "SmbBatchedOrchestrator          ", tuples_to_generate, partition, threads, KeyDistribution::uniform());
+                params.setParam("H-Page pool", warm_pool ? "warm" : "trimmed");
+                params.setParam("I-Repetition", repetition);
+                {
+                    PerfEventBlock e(1'000'000, params, !warm_pool && repetition == 0);
+
+                    SmbBatchedOrchestrator<T, partition> orchestrator(tuples_to_generate, threads);
+                    orchestrator.run();
+
+                    auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                    check_sum_of_written_tuples(tuples_to_generate, written_tuples);
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+    SlottedPagePool::trim();
+}
+
+// many small shuffles back-to-back, e.g. one per micro-batch of a streaming engine, on the persistent WorkerPool vs.
+// threads created and joined in every run
+template<typename T, unsigned... Partitions>
+void benchmark_SmallShuffleStream(const unsigned tuples_per_shuffle = 10'000, const unsigned shuffles = 10'000) {
+    auto run_benchmark = [&](auto partition) {
+        for (const bool persistent_workers: {false, true}) {
+            WorkerPool::set_persistent_workers(persistent_workers);
+            const unsigned threads = std::thread::hardware_concurrency();
+            auto run_orchestrators = [&](const std::string &impl, auto &&create_orchestrator) {
+                BenchmarkParameters params;
+                setup_benchmark_params<T>(params, impl, tuples_per_shuffle, partition, threads, KeyDistribution::uniform());
+                params.setParam("H-Workers", persistent_workers ? "persistent" : "spawn-per-run");
+                params.setParam("I-Shuffles", shuffles);
+                {
+                    PerfEventBlock e(static_cast<uint64_t>(tuples_per_shuffle) * shuffles, params, !persistent_workers && impl.starts_with("Smb"));
+                    for (unsigned shuffle = 0; shuffle < shuffles; ++shuffle) {
+                        auto orchestrator = create_orchestrator();
+                        orchestrator.run();
+                    }
+                }
+                auto orchestrator = create_orchestrator();
+                orchestrator.run();
+                auto written_tuples = orchestrator.get_written_tuples_per_partition();
+                check_sum_of_written_tuples(tuples_per_shuffle, written_tuples);
+            };
+            run_orchestrators("SmbBatchedOrchestrator          ", [&] { return SmbBatchedOrchestrator<T, partition>(tuples_per_shuffle, threads); });
+            run_orchestrators("RadixOrchestrator               ", [&] { return RadixOrchestrator<T, partition>(tuples_per_shuffle, threads); });
+            run_orchestrators("HybridOrchestrator              ", [&] { return HybridOrchestrator<T, partition>(tuples_per_shuffle, threads); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+        }
+    };
+    (run_benchmark(std::integral_constant<unsigned, Partitions>{}), ...);
+    WorkerPool::set_persistent_workers(true);
+}
+
+// generation only, compares the owning batch API (one allocation and copy per batch) with the span-based APIs
+template<typename T>
+void benchmark_TupleGeneratorBatchApi(const unsigned tuples_to_generate_base) {
+    const auto tuples_to_generate = static_cast<unsigned>(static_cast<double>(tuples_to_generate_base) * get_tuple_num_scaling_value<T>());
+    auto run_benchmark = [&](const std::string &api, auto &&consume) {
+        BenchmarkParameters params;
+        setup_benchmark_params<T>(params, api, tuples_to_generate, 0, 1, KeyDistribution::uniform());
+        BatchedTupleGenerator<T> generator(tuples_to_generate);
+        size_t checksum = 0;
+        {
+            PerfEventBlock e(tuples_to_generate, params, api.starts_with("getBatchOfTuples"));
+            checksum = consume(generator);
+        }
+        if (checksum != tuples_to_generate) {
+            std::cout << "Test failed: " << checksum << "/" << tuples_to_generate << std::endl;
+            exit(1);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+    };
+
+    run_benchmark("getBatchOfTuples                ", [](BatchedTupleGenerator<T> &generator) {
+        size_t tuples = 0;
+        for (auto [batch, batch_size] = generator.getBatchOfTuples(); batch; std::tie(batch, batch_size) = generator.getBatchOfTuples()) {
+            tuples += batch_size;
+        }
+        return tuples;
+    });
+    run_benchmark("next_batch                      ", [](BatchedTupleGenerator<T> &generator) {
+        size_t tuples = 0;
+        for (auto batch = generator.next_batch(); !batch.empty(); batch = generator.next_batch()) {
+            tuples += batch.size();
+        }
+        return tuples;
+    });
+    run_benchmark("fill                            ", [](BatchedTupleGenerator<T> &generator) {
+        const auto buffer = std::make_unique_for_overwrite<T[]>(BatchedTupleGenerator<T>::getBatchSize());
+        size_t tuples = 0;
+        for (size_t count = generator.fill({buffer.get(), BatchedTupleGenerator<T>::getBatchSize()}); count > 0; count = generator.fill({buffer.get(), BatchedTupleGenerator<T>::getBatchSize()})) {
+            tuples += count;
+        }
+        return tuples;
+    });
+}
+
 template<typename T>
 void warmup_run(const unsigned tuples_to_generate_base) {
     auto tuple_count_factor = get_tuple_num_scaling_value<T>();
@@ -475,42 +746,61 @@ void warmup_run(const unsigned tuples_to_generate_base) {
 }
 
 template<typename T, unsigned... Partitions>
-void run_benchmark_on_all_implementations(const unsigned tuples_to_generate_base) {
+void run_benchmark_on_all_implementations(const unsigned tuples_to_generate_base, const KeyDistribution &key_distribution = KeyDistribution::uniform()) {
     warmup_run<T>(tuples_to_generate_base / 4);
 
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_OnDemandSingleThreadOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_OnDemandSingleThreadOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_OnDemandOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_OnDemandOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_SmbSingleThreadOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_SmbSingleThreadOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_SmbOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_SmbOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_SmbLockFreeOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_SmbLockFreeOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_SmbBatchedOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_SmbBatchedOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_SmbLockFreeBatchedOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_ShuffleOperatorRuntimePath<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_RadixOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_AdaptiveShuffleOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_HybridOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_SmbLockFreeBatchedOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_LocalPagesAndMergeOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_RadixOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_CollaborativeMorselProcessingOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_HybridOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_CollaborativeMorselProcessingThreadPoolOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_LocalPagesAndMergeOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    benchmark_CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    benchmark_CollaborativeMorselProcessingOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
+    std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+    benchmark_CollaborativeMorselProcessingThreadPoolOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
+    std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
+    benchmark_CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
     // std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME_MS));
-    // benchmark_RadixSelectiveOrchestrator<T, Partitions...>(tuples_to_generate_base);
+    // benchmark_RadixSelectiveOrchestrator<T, Partitions...>(tuples_to_generate_base, key_distribution);
 }
 
 int main() {
     unsigned tuples_to_generate_base = 40'000'000u;
 
+    // cycles per tuple saved by handing out the generator buffer instead of a fresh copy per batch
+    benchmark_TupleGeneratorBatchApi<Tuple16>(tuples_to_generate_base);
+    benchmark_TupleGeneratorBatchApi<Tuple100>(tuples_to_generate_base);
+    benchmark_TupleGeneratorBatchApi<Tuple4>(tuples_to_generate_base);
+
+    // dTLB misses and page fault cost of the page allocation policies
+    benchmark_PageAllocation<Tuple16, 32, 1024>(tuples_to_generate_base);
+    benchmark_PageAllocation<Tuple100, 32, 1024>(tuples_to_generate_base);
+
+    // page faults and allocations avoided by recycling pages between shuffles
+    benchmark_PagePoolReuse<Tuple16, 32, 1024>(tuples_to_generate_base);
+
+    // thread creation and per-run setup of 10k small shuffles
+    benchmark_SmallShuffleStream<Tuple16, 32, 1024>();
+
     run_benchmark_on_all_implementations<Tuple16, 32>(tuples_to_generate_base);
     run_benchmark_on_all_implementations<Tuple16, 1024>(tuples_to_generate_base);
 
@@ -519,5 +809,12 @@ int main() {
 
     run_benchmark_on_all_implementations<Tuple4, 32>(tuples_to_generate_base);
     run_benchmark_on_all_implementations<Tuple4, 1024>(tuples_to_generate_base);
+
+    // skewed keys, e.g. a hot key receiving 30% of all tuples
+    const std::array key_distributions = {KeyDistribution::zipf(0.99), KeyDistribution::hot_key(0.3), KeyDistribution::sequential(), KeyDistribution::heavy_hitters(8, 0.5)};
+    for (const auto &key_distribution: key_distributions) {
+        run_benchmark_on_all_implementations<Tuple16, 32>(tuples_to_generate_base, key_distribution);
+        run_benchmark_on_all_implementations<Tuple16, 1024>(tuples_to_generate_base, key_distribution);
+    }
     return 0;
 }
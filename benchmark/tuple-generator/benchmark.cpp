@@ -1,8 +1,12 @@
 #include "../external/perfevent/PerfEvent.hpp"
 #include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-generator/Philox4x32.hpp"
 #include "tuple-types/tuple-types.hpp"
 #include "util/get_tuple_num_scaling_value.hpp"
 
+#include <cstddef>
+#include <cstring>
+
 constexpr size_t SEED = 42;
 
 template<typename T, size_t batch_size>
@@ -38,6 +42,48 @@ void benchmark_non_batched(size_t tuples_to_generate) {
     }
 }
 
+// the tuples are no uint64_t objects, so the checksum copies their first word instead of casting the pointer
+template<typename T>
+uint64_t get_first_word(const T *batch) {
+    uint64_t word;
+    std::memcpy(&word, batch, sizeof(word));
+    return word;
+}
+
+// raw random fill of the same amount of memory, mt19937_64 was the generator before Philox4x32
+template<typename T, size_t batch_size>
+void benchmark_mt19937_64(size_t tuples_to_generate) {
+    std::mt19937_64 gen(SEED);
+    alignas(32) T batch[batch_size];
+    constexpr size_t words_per_batch = sizeof(T) * batch_size / sizeof(uint64_t);
+    uint64_t checksum = 0;
+    for (size_t generated = 0; generated < tuples_to_generate; generated += batch_size) {
+        for (size_t i = 0; i < words_per_batch; ++i) {
+            const uint64_t word = gen();
+            std::memcpy(reinterpret_cast<std::byte *>(batch) + i * sizeof(word), &word, sizeof(word));
+        }
+        checksum ^= get_first_word(batch);
+    }
+    if (checksum == 0) {
+        std::cerr << "Warning: checksum is zero\n";
+    }
+}
+
+template<typename T, size_t batch_size>
+void benchmark_philox(size_t tuples_to_generate) {
+    const Philox4x32 rng(SEED);
+    alignas(32) T batch[batch_size];
+    constexpr size_t blocks_per_batch = sizeof(batch) / Philox4x32::block_size;
+    uint64_t checksum = 0;
+    for (size_t generated = 0, block = 0; generated < tuples_to_generate; generated += batch_size, block += blocks_per_batch) {
+        rng.fill(batch, block, blocks_per_batch);
+        checksum ^= get_first_word(batch);
+    }
+    if (checksum == 0) {
+        std::cerr << "Warning: checksum is zero\n";
+    }
+}
+
 template<typename T, size_t batch_size>
 void run_benchmarks(BenchmarkParameters &params, size_t tuples_to_generate, bool print_header = false) {
     // Set batch size parameter
@@ -56,6 +102,18 @@ void run_benchmarks(BenchmarkParameters &params, size_t tuples_to_generate, bool
         PerfEventBlock e(100'000, params, false);
         benchmark_batched<T, batch_size>(tuples_to_generate);
     }
+
+    params.setParam("A-Benchmark tuple-generator", "mt19937_64 fill");
+    {
+        PerfEventBlock e(100'000, params, false);
+        benchmark_mt19937_64<T, batch_size>(tuples_to_generate);
+    }
+
+    params.setParam("A-Benchmark tuple-generator", "philox fill");
+    {
+        PerfEventBlock e(100'000, params, false);
+        benchmark_philox<T, batch_size>(tuples_to_generate);
+    }
 }
 constexpr size_t batch_sizes[] = {32, 1024, 2048, 4096, 10 * 2048};
 int main() {
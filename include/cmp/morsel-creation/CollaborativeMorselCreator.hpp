@@ -1,32 +1,103 @@
 #pragma once
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/wait/adaptive_wait.hpp"
 #include <atomic>
-#include <condition_variable>
-#include <future>
-#include <mutex>
-#include <vector>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
 
-template<typename T>
+// One producer thread generates the input batch by batch into an append-only list, every consumer thread walks the
+// whole list. A batch is freed by the last consumer that moves past it, so only the window between the slowest
+// consumer and the producer stays resident instead of the whole input.
+template<typename T, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class CollaborativeMorselCreator {
-    BatchedTupleGenerator<T> generator;
-    std::vector<std::pair<std::unique_ptr<T[]>, size_t>> batches;
-    std::atomic<bool> done = false;
-    std::mutex mutex;
+    using Source = typename Input::Source;
+
+    struct Node {
+        std::unique_ptr<T[]> batch;
+        size_t size;
+        // consumers that did not move past this batch yet
+        std::atomic<unsigned> pending_consumers;
+        // set before the batch after it is published
+        Node *next = nullptr;
+    };
+
+    // set in available_batches once the producer is done
+    static constexpr size_t producer_done = size_t{1} << 63;
+
+    Source source;
+    unsigned num_consumers;
+    // number of published batches, or'ed with producer_done at the end
+    std::atomic<size_t> available_batches = 0;
+    std::atomic<Node *> first_node = nullptr;
+    // oldest batch that is not freed yet, batches are freed in order
+    std::atomic<Node *> oldest_node = nullptr;
     std::thread producer_thread;
 
 public:
-    explicit CollaborativeMorselCreator(size_t num_tuples)
-        : generator(num_tuples) {
+    // cursor of one consumer thread, the returned batch stays valid until the next call. A consumer that stops early
+    // leaves its batches to the destructor of the creator.
+    class Consumer {
+        CollaborativeMorselCreator *creator;
+        Node *current = nullptr;
+        size_t next_index = 0;
+
+        void release_current() {
+            if (current == nullptr) {
+                return;
+            }
+            if (current->pending_consumers.fetch_sub(1) == 1) {
+                creator->oldest_node.store(current->next);
+                delete current;
+            }
+            current = nullptr;
+        }
+
+    public:
+        explicit Consumer(CollaborativeMorselCreator &creator) : creator(&creator) {
+        }
+        Consumer(const Consumer &) = delete;
+        Consumer &operator=(const Consumer &) = delete;
+
+        // {nullptr, 0} once all batches were handed out
+        std::pair<T *, size_t> next_batch() {
+            const auto available = adaptive_wait(creator->available_batches, [this](const size_t available) { return (available & producer_done) != 0 || next_index < (available & ~producer_done); });
+            Node *next = nullptr;
+            if (next_index < (available & ~producer_done)) {
+                next = next_index == 0 ? creator->first_node.load() : current->next;
+                ++next_index;
+            }
+            release_current();
+            current = next;
+            return current == nullptr ? std::pair<T *, size_t>{nullptr, 0} : std::pair<T *, size_t>{current->batch.get(), current->size};
+        }
+    };
+
+    // every one of the num_consumers consumers has to walk the list to its end, otherwise batches are only freed by the destructor
+    CollaborativeMorselCreator(const Input &input, const unsigned num_consumers)
+        : source(input.create_source(0, input.get_num_tuples())), num_consumers(num_consumers) {
         producer_thread = std::thread([this]() {
-            while (true) {
-                auto [batch, size] = generator.getBatchOfTuples();
+            Node *last_node = nullptr;
+            for (size_t published = 0;; ++published) {
+                auto batch = std::make_unique_for_overwrite<T[]>(Source::getBatchSize());
+                const auto size = source.fill({batch.get(), Source::getBatchSize()});
                 if (size == 0) {
+                    available_batches.store(published | producer_done);
                     break;
                 }
-                std::lock_guard lock(mutex);
-                batches.emplace_back(std::move(batch), size);
+                auto *node = new Node{std::move(batch), size, this->num_consumers};
+                if (last_node == nullptr) {
+                    first_node.store(node);
+                    oldest_node.store(node);
+                } else {
+                    last_node->next = node;
+                }
+                last_node = node;
+                available_batches.store(published + 1);
+                available_batches.notify_all();
             }
-            done = true;
+            available_batches.notify_all();
         });
     }
 
@@ -34,20 +105,12 @@ public:
         if (producer_thread.joinable()) {
             producer_thread.join();
         }
+        for (auto *node = oldest_node.load(); node != nullptr;) {
+            delete std::exchange(node, node->next);
+        }
     }
 
-    auto requestBatchCollaboratively(unsigned next_index_to_process) -> std::pair<T *, size_t> {
-        while (true) {
-            std::lock_guard lock(mutex);
-
-            if (next_index_to_process < batches.size()) {
-                auto &current_batch = batches[next_index_to_process];
-                return {current_batch.first.get(), current_batch.second};
-            }
-
-            if (done) {
-                return {nullptr, 0};
-            }
-        }
+    Consumer get_consumer() {
+        return Consumer(*this);
     }
 };
@@ -1,29 +1,30 @@
 #pragma once
 
-#include <thread>
-
 #include "cmp/morsel-creation/CollaborativeMorselCreator.hpp"
 #include "slotted-page/page-manager/OnDemandSingleThreadPageManager.hpp"
 #include "cmp/worker/process_morsel_cmp_batched.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class CollaborativeMorselProcessingOrchestrator {
-    CollaborativeMorselCreator<T> morsel_creator;
+    CollaborativeMorselCreator<T, Input> morsel_creator;
     OnDemandSingleThreadPageManager<T, partitions, page_size> page_manager;
     size_t num_threads;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit CollaborativeMorselProcessingOrchestrator(size_t num_tuples, size_t num_threads) : morsel_creator(num_tuples), page_manager(), num_threads(num_threads) {
+    explicit CollaborativeMorselProcessingOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : CollaborativeMorselProcessingOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    CollaborativeMorselProcessingOrchestrator(const Input &input, const size_t num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement()) : morsel_creator(input, num_threads), page_manager(), num_threads(num_threads), thread_placement(thread_placement) {
     }
 
     void run() {
-        std::vector<std::jthread> threads;
-        threads.reserve(num_threads);
-        for (unsigned i = 0; i < num_threads; i++) {
-            threads.emplace_back([this, i] {
-                process_morsel_cmp_batched<T, partitions, page_size>(i, num_threads, morsel_creator, page_manager);
-            });
-        }
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        WorkerPool::run(cpus, [this](const size_t i) {
+            process_morsel_cmp_batched<T, partitions, page_size, PartitionHash>(i, num_threads, morsel_creator, page_manager);
+        });
     }
     std::vector<size_t> get_written_tuples_per_partition() {
         return page_manager.get_written_tuples_per_partition();
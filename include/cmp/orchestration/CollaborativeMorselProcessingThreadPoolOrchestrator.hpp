@@ -2,33 +2,42 @@
 
 #include "cmp/thread-pool/CmpThreadPool.hpp"
 #include "slotted-page/page-manager/OnDemandSingleThreadPageManager.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T, 10 * 2048>>
 class CollaborativeMorselProcessingThreadPoolOrchestrator {
-    BatchedTupleGenerator<T, 10 * 2048> tuple_generator;
+    using Source = typename Input::Source;
+    Source tuple_source;
     OnDemandSingleThreadPageManager<T, partitions, page_size> page_manager;
     size_t num_threads;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit CollaborativeMorselProcessingThreadPoolOrchestrator(size_t num_tuples, size_t num_threads) : tuple_generator(num_tuples), page_manager(), num_threads(num_threads) {
+    explicit CollaborativeMorselProcessingThreadPoolOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : CollaborativeMorselProcessingThreadPoolOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    CollaborativeMorselProcessingThreadPoolOrchestrator(const Input &input, const size_t num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement())
+        : tuple_source(input.create_source(0, input.get_num_tuples())), page_manager(), num_threads(num_threads), thread_placement(thread_placement) {
     }
 
     void run() {
         num_threads = std::min(std::max(num_threads - 1ul, 1ul), partitions);
-        CmpThreadPool<T, partitions, page_size> thread_pool(num_threads, page_manager);
-        {
-            constexpr auto fetch_threads = 1;
-            std::vector<std::jthread> threads;
-            threads.reserve(fetch_threads);
-            for (int i = 0; i < fetch_threads; i++) {
-                threads.emplace_back([this, &thread_pool] {
-                    for (auto [batch, batch_size] = tuple_generator.getBatchOfTuples(); batch != nullptr; std::tie(batch, batch_size) = tuple_generator.getBatchOfTuples()) {
-                        thread_pool.dispatchTask(std::move(batch), batch_size);
-                    }
-                });
+        // the fetch thread takes the first CPU, the workers the following ones
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads + 1);
+        CmpThreadPool<T, partitions, page_size, PartitionHash> thread_pool(num_threads, page_manager, {cpus.begin() + 1, cpus.end()});
+        // single fetch thread
+        WorkerPool::run({cpus.front()}, [this, &thread_pool](size_t) {
+            while (true) {
+                auto batch = std::make_unique_for_overwrite<T[]>(Source::getBatchSize());
+                const auto batch_size = tuple_source.fill({batch.get(), Source::getBatchSize()});
+                if (batch_size == 0) {
+                    break;
+                }
+                thread_pool.dispatchTask(std::move(batch), batch_size);
             }
-        }
+        });
         thread_pool.stop();
     }
     std::vector<size_t> get_written_tuples_per_partition() {
@@ -3,16 +3,25 @@
 
 #include "cmp/thread-pool/CmpThreadPoolWithProcessingUnits.hpp"
 #include "slotted-page/page-manager/OnDemandPageManager.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T, 10 * 2048>>
 class CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator {
+    using Source = typename Input::Source;
     OnDemandPageManager<T, partitions, page_size> page_manager;
+    Input input;
     size_t num_tuples;
     size_t num_threads;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator(const size_t num_tuples, const size_t num_threads) : page_manager(), num_tuples(num_tuples), num_threads(num_threads) {
+    explicit CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator(Input input, const size_t num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement())
+        : page_manager(), input(std::move(input)), num_tuples(this->input.get_num_tuples()), num_threads(num_threads), thread_placement(thread_placement) {
     }
 
     void run() {
@@ -20,23 +29,27 @@ public:
         const unsigned generator_thread_count = numProcessingUnits;
         unsigned partition_thread_count = std::max(num_threads - numProcessingUnits, 1ul);
 
-        CmpThreadPoolWithProcessingUnits<T, partitions, page_size> thread_pool(numProcessingUnits, partition_thread_count, page_manager);
-        {
-            std::vector<std::jthread> generator_threads;
-            generator_threads.reserve(generator_thread_count);
-            for (unsigned i = 0; i < generator_thread_count; i++) {
-                generator_threads.emplace_back([&, i] {
-                    BatchedTupleGenerator<T, 10 * 2048> tuple_creator(num_tuples / generator_thread_count + (num_tuples % generator_thread_count > i ? 1 : 0));
-                    while (true) {
-                        auto [batch, batch_size] = tuple_creator.getBatchOfTuples();
-                        if (batch == nullptr) {
-                            break;
-                        }
-                        thread_pool.dispatchTask(i, std::move(batch), batch_size);
-                    }
-                });
-            }
+        // the generator and the workers of a processing unit share an L3 with ThreadPlacement::PerL3
+        const size_t max_workers_per_unit = std::min<size_t>(partition_thread_count / numProcessingUnits + (partition_thread_count % numProcessingUnits != 0), partitions);
+        const auto unit_cpus = ThreadPinning::get_cpus_of_units(thread_placement, numProcessingUnits, 1 + max_workers_per_unit);
+        CmpThreadPoolWithProcessingUnits<T, partitions, page_size, PartitionHash> thread_pool(numProcessingUnits, partition_thread_count, page_manager, unit_cpus);
+        std::vector<int> generator_cpus(generator_thread_count);
+        for (unsigned i = 0; i < generator_thread_count; i++) {
+            generator_cpus[i] = unit_cpus[i][0];
         }
+        WorkerPool::run(generator_cpus, [&](const size_t i) {
+            const size_t tuples_of_thread = num_tuples / generator_thread_count + (num_tuples % generator_thread_count > i ? 1 : 0);
+            const size_t first_tuple = i * (num_tuples / generator_thread_count) + std::min<size_t>(i, num_tuples % generator_thread_count);
+            Source tuple_source = input.create_source(first_tuple, tuples_of_thread);
+            while (true) {
+                auto *batch = thread_pool.acquire_batch(i, Source::getBatchSize());
+                const auto batch_size = tuple_source.fill({batch, Source::getBatchSize()});
+                if (batch_size == 0) {
+                    break;
+                }
+                thread_pool.dispatchTask(i, batch_size);
+            }
+        });
         for (unsigned pu = 0; pu < numProcessingUnits; pu++) {
             thread_pool.stop(pu);
         }
@@ -2,64 +2,58 @@
 
 #include "cmp/worker/CmpProcessor.hpp"
 #include "util/padded/PaddedAtomic.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/wait/TaskEpoch.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
 #include <atomic>
 #include <chrono>
 #include <thread>
 #include <vector>
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash>
 class CmpThreadPool {
     OnDemandSingleThreadPageManager<T, partitions, page_size> &page_manager;
-    std::vector<std::jthread> workers;
+    WorkerPool::Job workers;
     std::pair<std::unique_ptr<T[]>, size_t> current_task = {nullptr, 0};
-    const unsigned all_workers_done_mask;
-    PaddedAtomic<unsigned> thread_finished;
+    TaskEpoch task_epoch;
     PaddedAtomic<bool> running;
     std::mutex dispatch_mutex{};
 
 public:
-    explicit CmpThreadPool(size_t numThreads, OnDemandSingleThreadPageManager<T, partitions, page_size> &page_manager)
-        : page_manager(page_manager), all_workers_done_mask((1u << numThreads) - 1), thread_finished(all_workers_done_mask), running(true) {
-        workers.reserve(numThreads);
-        for (size_t i = 0; i < numThreads; ++i) {
-            workers.emplace_back([this, i, numThreads] {
-                CmpProcessor<T, partitions, page_size> processor(i, numThreads, this->page_manager);
-                T *last_ptr = nullptr;
-                while (running.load()) {
-                    while ((thread_finished.load() & 1u << i) != 0) {
-                    }
-                    auto new_ptr = current_task.first.get();
-                    if (running.load() && new_ptr != last_ptr) {
-                        last_ptr = new_ptr;
-                        processor.process(current_task.first.get(), current_task.second);
-                        thread_finished |= 1u << i;
-                    }
+    // worker i is pinned to cpus[i] if given
+    explicit CmpThreadPool(size_t numThreads, OnDemandSingleThreadPageManager<T, partitions, page_size> &page_manager, const std::vector<int> &cpus = {})
+        : page_manager(page_manager), task_epoch(numThreads), running(true) {
+        std::vector<int> worker_cpus(numThreads, -1);
+        std::copy_n(cpus.begin(), std::min(cpus.size(), numThreads), worker_cpus.begin());
+        workers = WorkerPool::start(worker_cpus, [this, numThreads](const size_t i) {
+            CmpProcessor<T, partitions, page_size, PartitionHash> processor(i, numThreads, this->page_manager);
+            uint64_t seen_epoch = 0;
+            while (true) {
+                seen_epoch = task_epoch.wait_for_task(seen_epoch);
+                if (!running.load()) {
+                    break;
                 }
+                processor.process(current_task.first.get(), current_task.second);
+                task_epoch.finish();
+            }
 
-                processor.process(nullptr, 0);
-            });
-        }
+            processor.process(nullptr, 0);
+        });
     }
 
     void dispatchTask(std::unique_ptr<T[]> data, size_t size) {
         std::lock_guard lock(dispatch_mutex);
-        while (thread_finished.load() != all_workers_done_mask) {
-        }
+        task_epoch.wait_for_workers();
         current_task.first = std::move(data);
         current_task.second = size;
-        thread_finished.store(0);
+        task_epoch.publish();
     }
 
     void stop() {
-        while (thread_finished.load() != all_workers_done_mask) {
-        }
+        task_epoch.wait_for_workers();
         running.store(false);
         current_task = {nullptr, 0};
-        thread_finished.store(0);
-        for (auto &worker: workers) {
-            if (worker.joinable()) {
-                worker.join();
-            }
-        }
+        task_epoch.publish();
+        workers.wait();
     }
 };
@@ -3,81 +3,124 @@
 #include "cmp/worker/CmpProcessorOfUnit.hpp"
 #include "slotted-page/page-manager/OnDemandPageManager.hpp"
 #include "util/padded/PaddedAtomic.hpp"
-#include "util/padded/PaddedMutex.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/wait/adaptive_wait.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
-#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <vector>
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+// Every processing unit has one producer and a ring of batches its workers consume in order. The producer fills the
+// next free slot while the workers still partition older batches, i.e. it may run up to ring_slots batches ahead of
+// the slowest worker of its unit. A slot is handed back to the producer, memory included, once all workers of the
+// unit processed it.
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash>
 class CmpThreadPoolWithProcessingUnits {
+    struct alignas(std::hardware_destructive_interference_size) Slot {
+        std::unique_ptr<T[]> batch;
+        size_t capacity = 0;
+        size_t size = 0;
+        // published by stop, the workers flush their buffers and leave
+        bool last = false;
+        // workers that still have to process the batch, the producer reuses the slot at 0
+        std::atomic<unsigned> pending_workers = 0;
+    };
+
+    struct ProcessingUnit {
+        std::unique_ptr<Slot[]> ring;
+        // number of published batches, batch b lives in ring[b % ring_slots]
+        PaddedAtomic<uint64_t> published_batches{0};
+        unsigned num_workers = 0;
+        WorkerPool::Job workers;
+    };
+
     OnDemandPageManager<T, partitions, page_size> &page_manager;
     const unsigned processingUnits;
     const unsigned worker_threads;
+    const size_t ring_slots;
+    std::unique_ptr<ProcessingUnit[]> units;
 
-    std::vector<std::vector<std::jthread>> workers;
-    std::vector<std::pair<std::unique_ptr<T[]>, size_t>> current_tasks;
-    std::vector<unsigned> all_workers_done_mask;
-    std::vector<PaddedAtomic<bool>> running;
-    std::vector<PaddedAtomic<unsigned>> thread_finished;
-    std::vector<PaddedMutex> dispatch_mutex;
-
-public:
-    explicit CmpThreadPoolWithProcessingUnits(const unsigned processingUnits, const unsigned worker_threads, OnDemandPageManager<T, partitions, page_size> &page_manager)
-        : page_manager(page_manager), processingUnits(processingUnits), worker_threads(worker_threads) {
-        current_tasks.reserve(processingUnits);
-        all_workers_done_mask.reserve(processingUnits);
-        {
-            std::vector<PaddedAtomic<unsigned>> temp_thread_finished(processingUnits);
-            thread_finished.swap(temp_thread_finished);
+    Slot &next_free_slot(ProcessingUnit &unit) {
+        auto &slot = unit.ring[unit.published_batches.load(std::memory_order_relaxed) % ring_slots];
+        adaptive_wait(slot.pending_workers, [](const unsigned pending) { return pending == 0; });
+        return slot;
+    }
 
-            std::vector<PaddedAtomic<bool>> temp_running(processingUnits);
-            running.swap(temp_running);
+    void publish(ProcessingUnit &unit, const size_t size, const bool last) {
+        auto &slot = unit.ring[unit.published_batches.load(std::memory_order_relaxed) % ring_slots];
+        slot.size = size;
+        slot.last = last;
+        slot.pending_workers.store(unit.num_workers, std::memory_order_relaxed);
+        unit.published_batches.value.fetch_add(1);
+        unit.published_batches.notify_all();
+    }
 
-            std::vector<PaddedMutex> temp_dispatch_mutex(processingUnits);
-            dispatch_mutex.swap(temp_dispatch_mutex);
+    void work(ProcessingUnit &unit, CmpProcessorOfUnit<T, partitions, page_size, PartitionHash> &processor) {
+        for (uint64_t next_batch = 0;; ++next_batch) {
+            adaptive_wait(unit.published_batches.value, [next_batch](const uint64_t published) { return published > next_batch; });
+            auto &slot = unit.ring[next_batch % ring_slots];
+            // the empty batch of stop flushes the buffers of the processor
+            processor.process(slot.batch.get(), slot.size);
+            // the slot may be refilled as soon as the last worker released it
+            const bool last = slot.last;
+            if (slot.pending_workers.fetch_sub(1) == 1) {
+                slot.pending_workers.notify_all();
+            }
+            if (last) {
+                return;
+            }
         }
+    }
+
+public:
+    static constexpr size_t default_ring_slots = 4;
 
+    // worker w of unit pu is pinned to unit_cpus[pu][1 + w] if given, unit_cpus[pu][0] belongs to the generator of the unit
+    explicit CmpThreadPoolWithProcessingUnits(const unsigned processingUnits, const unsigned worker_threads, OnDemandPageManager<T, partitions, page_size> &page_manager, const std::vector<std::vector<int>> &unit_cpus = {}, const size_t ring_slots = default_ring_slots)
+        : page_manager(page_manager), processingUnits(processingUnits), worker_threads(worker_threads), ring_slots(std::max<size_t>(ring_slots, 1)), units(std::make_unique<ProcessingUnit[]>(processingUnits)) {
         for (size_t pu = 0; pu < processingUnits; ++pu) {
-            current_tasks.emplace_back(std::make_pair(nullptr, 0));
-            running[pu].store(true);
-            workers.emplace_back();
+            auto &unit = units[pu];
+            unit.ring = std::make_unique<Slot[]>(this->ring_slots);
 
             unsigned num_worker = worker_threads / processingUnits + (pu < worker_threads % processingUnits ? 1 : 0);
             num_worker = std::min(static_cast<unsigned>(partitions), num_worker);
-            all_workers_done_mask.emplace_back((1u << num_worker) - 1);
+            unit.num_workers = num_worker;
 
-            thread_finished[pu].store(all_workers_done_mask[pu]);
+            std::vector<int> worker_cpus(num_worker, -1);
             for (size_t w = 0; w < num_worker; ++w) {
-                workers[pu].emplace_back([this, pu, w, num_worker, worker_threads] {
-                    CmpProcessorOfUnit<T, partitions, page_size> processor(w, num_worker, worker_threads, this->page_manager);
-                    while (running[pu].load()) {
-                        while ((thread_finished[pu].load() & 1u << w) != 0) {
-                        }
-                        processor.process(current_tasks[pu].first.get(), current_tasks[pu].second);
-                        thread_finished[pu] |= 1u << w;
-                    }
-                });
+                if (pu < unit_cpus.size() && 1 + w < unit_cpus[pu].size()) {
+                    worker_cpus[w] = unit_cpus[pu][1 + w];
+                }
             }
+            unit.workers = WorkerPool::start(worker_cpus, [this, &unit, num_worker, worker_threads](const size_t w) {
+                CmpProcessorOfUnit<T, partitions, page_size, PartitionHash> processor(w, num_worker, worker_threads, this->page_manager);
+                work(unit, processor);
+            });
         }
     }
 
-    void dispatchTask(unsigned processingUnitId, std::unique_ptr<T[]> data, size_t size) {
-        while (thread_finished[processingUnitId].load() != all_workers_done_mask[processingUnitId]) {
+    // buffer for the next batch of the unit with room for at least capacity tuples, waits while the ring is full
+    T *acquire_batch(const unsigned processingUnitId, const size_t capacity) {
+        auto &slot = next_free_slot(units[processingUnitId]);
+        if (slot.capacity < capacity) {
+            slot.batch = std::make_unique_for_overwrite<T[]>(capacity);
+            slot.capacity = capacity;
         }
-        current_tasks[processingUnitId] = std::make_pair(std::move(data), size);
-        thread_finished[processingUnitId].store(0);
+        return slot.batch.get();
+    }
+
+    // hands the first size tuples of the buffer from acquire_batch to the workers of the unit
+    void dispatchTask(const unsigned processingUnitId, const size_t size) {
+        publish(units[processingUnitId], size, false);
     }
 
     void stop(const unsigned processingUnitId) {
-        while (thread_finished[processingUnitId].load() != all_workers_done_mask[processingUnitId]) {
-        }
-        current_tasks[processingUnitId] = {nullptr, 0};
-        running[processingUnitId].store(false);
-        thread_finished[processingUnitId].store(0);
-        for (auto &worker: workers[processingUnitId]) {
-            if (worker.joinable()) {
-                worker.join();
-            }
-        }
+        auto &unit = units[processingUnitId];
+        next_free_slot(unit);
+        publish(unit, 0, true);
+        unit.workers.wait();
     }
 };
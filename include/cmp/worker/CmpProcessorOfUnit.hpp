@@ -4,9 +4,10 @@
 #include "util/partitioning_function.hpp"
 #include <array>
 #include <memory>
+#include <vector>
 
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash>
 class CmpProcessorOfUnit {
     static constexpr unsigned buffer_base_value = 4 * 1048;
     unsigned start_partition;
@@ -15,6 +16,7 @@ class CmpProcessorOfUnit {
 
     std::array<unsigned, partitions> buffer_index = {};
     std::unique_ptr<T[]> buffer;
+    std::vector<uint16_t> partition_ids;
     OnDemandPageManager<T, partitions, page_size> &page_manager;
 
 public:
@@ -30,9 +32,13 @@ public:
     }
 
     void process(T *batch_ptr, const size_t batch_size) {
+        if (partition_ids.size() < batch_size) {
+            partition_ids.resize(batch_size);
+        }
+        partition_function_batch<T, partitions, PartitionHash>(batch_ptr, batch_size, partition_ids.data());
         for (size_t i = 0; i < batch_size; ++i) {
             const auto &tuple = batch_ptr[i];
-            const auto partition = partition_function<T, partitions>(tuple);
+            const auto partition = partition_ids[i];
             if (partition < start_partition || partition >= end_partition) {
                 continue;
             }
@@ -3,8 +3,8 @@
 #include "slotted-page/page-manager/OnDemandSingleThreadPageManager.hpp"
 #include "util/partitioning_function.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
-void process_morsel_cmp_batched(const unsigned thread_id, const unsigned total_thread_count, CollaborativeMorselCreator<T> &morsel_creator, OnDemandSingleThreadPageManager<T, partitions, page_size> &page_manager) {
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, typename Input>
+void process_morsel_cmp_batched(const unsigned thread_id, const unsigned total_thread_count, CollaborativeMorselCreator<T, Input> &morsel_creator, OnDemandSingleThreadPageManager<T, partitions, page_size> &page_manager) {
     auto partitions_per_thread = partitions / total_thread_count;
     auto remainder_partitions = partitions % total_thread_count;
     auto start_partition = thread_id * partitions_per_thread + std::min(thread_id, static_cast<unsigned>(remainder_partitions));
@@ -19,13 +19,15 @@ void process_morsel_cmp_batched(const unsigned thread_id, const unsigned total_t
     std::array<unsigned, partitions> buffer_index = {};
     const auto total_buffer_size = 8 * 1024 * 1024 / sizeof(T);
     std::unique_ptr<T[]> buffer = std::make_unique<T[]>(total_buffer_size);
+    std::unique_ptr<uint16_t[]> partition_ids = std::make_unique<uint16_t[]>(Input::Source::getBatchSize());
     const auto buffer_size_per_partition = total_buffer_size / partitions_to_consider;
-    auto batch_to_process = 0u;
+    auto consumer = morsel_creator.get_consumer();
 
-    for (auto [batch, batch_size] = morsel_creator.requestBatchCollaboratively(batch_to_process++); batch != nullptr; std::tie(batch, batch_size) = morsel_creator.requestBatchCollaboratively(batch_to_process++)) {
+    for (auto [batch, batch_size] = consumer.next_batch(); batch != nullptr; std::tie(batch, batch_size) = consumer.next_batch()) {
+        partition_function_batch<T, partitions, PartitionHash>(batch, batch_size, partition_ids.get());
         for (size_t i = 0; i < batch_size; ++i) {
             auto &tuple = batch[i];
-            auto partition = partition_function<T, partitions>(tuple);
+            auto partition = partition_ids[i];
             if (partition < start_partition || partition >= end_partition) {
                 continue;
             }
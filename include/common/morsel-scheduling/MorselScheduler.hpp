@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+
+// How the SMB-style orchestrators split their input between threads.
+enum class MorselDispatch {
+    // one fixed share of num_tuples / num_threads per thread
+    Static,
+    // morsels from a per-thread range, idle threads steal from the others (MorselScheduler)
+    WorkStealing,
+};
+
+inline const char *get_morsel_dispatch_name(const MorselDispatch dispatch) {
+    switch (dispatch) {
+        case MorselDispatch::Static:
+            return "static";
+        case MorselDispatch::WorkStealing:
+            return "work-stealing";
+    }
+    return "unknown";
+}
+
+struct Morsel {
+    size_t first_tuple;
+    // 0 once all tuples have been handed out
+    size_t num_tuples;
+};
+
+// Morsel-driven dispatch of the tuple indices [0, num_tuples) to num_threads threads. Every thread owns a contiguous
+// range and takes morsels from its front. A thread whose range is exhausted steals the back half of the largest
+// remaining range, so a preempted or remote thread only holds back the morsel it is working on.
+// All morsel boundaries are multiples of alignment (e.g. the batch size of the tuple source).
+class MorselScheduler {
+    struct alignas(std::hardware_destructive_interference_size) Range {
+        std::mutex mutex;
+        // written under the mutex, read without it to pick a victim
+        std::atomic<size_t> begin = 0;
+        std::atomic<size_t> end = 0;
+    };
+
+    std::unique_ptr<Range[]> ranges;
+    size_t num_threads;
+    size_t morsel_size;
+    size_t alignment;
+    std::atomic<size_t> stolen_morsels = 0;
+
+    [[nodiscard]] size_t align_down(const size_t value) const {
+        return value / alignment * alignment;
+    }
+
+    // takes the next morsel of range, must be called with its mutex held
+    Morsel take_front(Range &range) const {
+        const auto begin = range.begin.load(std::memory_order_relaxed);
+        const auto end = range.end.load(std::memory_order_relaxed);
+        const auto num_tuples = std::min(morsel_size, end - begin);
+        range.begin.store(begin + num_tuples, std::memory_order_relaxed);
+        return {begin, num_tuples};
+    }
+
+    // moves the back half of the largest other range into the range of thread, false if there is nothing left
+    bool steal(const size_t thread) {
+        while (true) {
+            size_t victim = num_threads;
+            size_t largest_remaining = 0;
+            for (size_t i = 0; i < num_threads; ++i) {
+                const auto begin = ranges[i].begin.load(std::memory_order_relaxed);
+                const auto end = ranges[i].end.load(std::memory_order_relaxed);
+                const auto remaining = end > begin ? end - begin : 0;
+                if (i != thread && remaining > largest_remaining) {
+                    victim = i;
+                    largest_remaining = remaining;
+                }
+            }
+            if (victim == num_threads) {
+                return false;
+            }
+
+            size_t stolen_begin, stolen_end;
+            {
+                std::lock_guard lock(ranges[victim].mutex);
+                const auto begin = ranges[victim].begin.load(std::memory_order_relaxed);
+                const auto end = ranges[victim].end.load(std::memory_order_relaxed);
+                if (begin == end) {
+                    // the victim finished in the meantime, pick another one
+                    continue;
+                }
+                // the victim keeps the aligned front half, a remainder of at most one aligned unit is taken as a whole
+                stolen_begin = begin + align_down((end - begin) / 2);
+                stolen_end = end;
+                ranges[victim].end.store(stolen_begin, std::memory_order_relaxed);
+            }
+            std::lock_guard lock(ranges[thread].mutex);
+            ranges[thread].begin.store(stolen_begin, std::memory_order_relaxed);
+            ranges[thread].end.store(stolen_end, std::memory_order_relaxed);
+            stolen_morsels.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+public:
+    // large enough to amortize a source per morsel, small enough that a straggler's last morsel is short
+    static constexpr size_t default_morsel_size = 64 * 1024;
+
+    MorselScheduler(const size_t num_tuples, const size_t num_threads, const size_t morsel_size, const size_t alignment = 1)
+        : ranges(std::make_unique<Range[]>(num_threads)), num_threads(num_threads), alignment(std::max<size_t>(alignment, 1)) {
+        this->morsel_size = std::max(align_down(morsel_size), this->alignment);
+        const auto units = (num_tuples + this->alignment - 1) / this->alignment;
+        size_t first_tuple = 0;
+        for (size_t i = 0; i < num_threads; ++i) {
+            const auto units_of_thread = units / num_threads + (i < units % num_threads);
+            const auto last_tuple = std::min(first_tuple + units_of_thread * this->alignment, num_tuples);
+            ranges[i].begin.store(first_tuple);
+            ranges[i].end.store(last_tuple);
+            first_tuple = last_tuple;
+        }
+    }
+
+    Morsel next_morsel(const size_t thread) {
+        do {
+            std::lock_guard lock(ranges[thread].mutex);
+            if (ranges[thread].begin.load(std::memory_order_relaxed) != ranges[thread].end.load(std::memory_order_relaxed)) {
+                return take_front(ranges[thread]);
+            }
+        } while (steal(thread));
+        return {0, 0};
+    }
+
+    // number of successful steals, i.e. how unbalanced the threads were
+    [[nodiscard]] size_t get_stolen_morsels() const {
+        return stolen_morsels.load();
+    }
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <optional>
+#include <span>
+
+#include "common/morsel-scheduling/MorselScheduler.hpp"
+#include "tuple-source/TupleSource.hpp"
+
+// TupleSource of one thread that pulls morsels from a MorselScheduler and reads each of them through a source of
+// the input, so the SMB-style workers run unchanged on dynamically dispatched morsels.
+template<typename T, TupleSourceFactory<T> Input>
+class ScheduledSource {
+    using Source = typename Input::Source;
+
+    const Input *input;
+    MorselScheduler *scheduler;
+    size_t thread;
+    std::optional<Source> source;
+
+    bool next_morsel() {
+        const auto [first_tuple, num_tuples] = scheduler->next_morsel(thread);
+        if (num_tuples == 0) {
+            return false;
+        }
+        source.emplace(input->create_source(first_tuple, num_tuples));
+        return true;
+    }
+
+public:
+    ScheduledSource(const Input &input, MorselScheduler &scheduler, const size_t thread) : input(&input), scheduler(&scheduler), thread(thread) {
+    }
+
+    std::span<const T> next_batch() {
+        while (true) {
+            if (source) {
+                if (const auto batch = source->next_batch(); !batch.empty()) {
+                    return batch;
+                }
+            }
+            if (!next_morsel()) {
+                return {};
+            }
+        }
+    }
+
+    // may return fewer tuples than out.size() at the end of a morsel
+    size_t fill(const std::span<T> out) {
+        while (true) {
+            if (source) {
+                if (const auto written = source->fill(out); written > 0) {
+                    return written;
+                }
+            }
+            if (!next_morsel()) {
+                return 0;
+            }
+        }
+    }
+
+    static auto getBatchSize() {
+        return Source::getBatchSize();
+    }
+};
@@ -20,13 +20,9 @@ public:
         const size_t tuples_left = tuples_to_generate - generated_tuples;
         const size_t tuples_to_generate_now = std::min(max_tuple_count_in_chunk, tuples_left);
 
-        std::unique_ptr<T[]> chunk = std::make_unique<T[]>(tuples_to_generate_now);
-        for (size_t i = 0; i < tuples_to_generate_now;) {
-            const auto [batch, count] = generator.getBatchOfTuples(tuples_to_generate_now - i);
-            assert(!(count == 0 || batch == nullptr));
-            std::copy(batch.get(), batch.get() + count, chunk.get() + i);
-            i += count;
-        }
+        std::unique_ptr<T[]> chunk = std::make_unique_for_overwrite<T[]>(tuples_to_generate_now);
+        [[maybe_unused]] const auto count = generator.fill({chunk.get(), tuples_to_generate_now});
+        assert(count == tuples_to_generate_now);
         tuples_to_generate -= tuples_to_generate_now;
 
         return std::make_pair(std::move(chunk), tuples_to_generate_now);
@@ -2,35 +2,41 @@
 
 #include "hybrid/worker/request_and_process_chunk.hpp"
 #include "slotted-page/page-manager/HybridPageManager.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
 #include <deque>
-#include <thread>
 #include <vector>
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T, 10 * 2048>>
 class HybridOrchestrator {
     HybridPageManager<T, partitions, page_size> page_manager;
+    Input input;
     size_t num_tuples;
     size_t num_threads;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit HybridOrchestrator(const size_t num_tuples, const size_t num_threads)
-        : page_manager(), num_tuples(num_tuples), num_threads(num_threads) {
+    explicit HybridOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : HybridOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    HybridOrchestrator(Input input, const size_t num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement()) : page_manager(), input(std::move(input)), num_tuples(this->input.get_num_tuples()), num_threads(num_threads), thread_placement(thread_placement) {
     }
 
     void run() {
-        std::deque<BatchedTupleGenerator<T, 10 * 2048>> generators;
-        std::vector<std::jthread> threads;
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        std::deque<typename Input::Source> sources;
 
+        size_t first_tuple = 0;
         for (size_t i = 0; i < num_threads; ++i) {
             const auto tuple_to_generate = num_tuples / num_threads + (i < num_tuples % num_threads);
-            generators.emplace_back(tuple_to_generate);
-            auto &generator = generators.back();
-
-            threads.emplace_back([this, &generator] {
-                request_and_process_chunk<T, partitions>(page_manager, generator, num_threads);
-            });
+            sources.emplace_back(input.create_source(first_tuple, tuple_to_generate));
+            first_tuple += tuple_to_generate;
         }
+        WorkerPool::run(cpus, [&](const size_t i) {
+            request_and_process_chunk<T, partitions, page_size, PartitionHash>(page_manager, sources[i], num_threads);
+        });
     }
     std::vector<size_t> get_written_tuples_per_partition() {
         return page_manager.get_written_tuples_per_partition();
@@ -2,8 +2,9 @@
 
 #include "slotted-page/page-implementation/RawSlottedPage.hpp"
 #include "slotted-page/page-manager/HybridPageManager.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/TupleSource.hpp"
 #include "util/partitioning_function.hpp"
+#include "util/worker-pool/get_worker_buffer.hpp"
 
 #include <array>
 #include <memory>
@@ -33,35 +34,38 @@ void write_out_buffer_of_partition(T *buffer, std::array<std::vector<PageWriteIn
 }
 
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
-void request_and_process_chunk(HybridPageManager<T, partitions, page_size> &page_manager, BatchedTupleGenerator<T, 10 * 2048> &tuple_generator, const size_t num_threads) {
+// The partition ids of a batch are computed once and serve both the histogram and the scatter. The write info and the
+// buffers are per-thread objects of the worker, so a chunk only appends page ranges to vectors that keep their capacity.
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSource<T> Source>
+void request_and_process_chunk(HybridPageManager<T, partitions, page_size> &page_manager, Source &tuple_source, const size_t num_threads) {
     static constexpr unsigned buffer_base_value = 2 * 1024;
     const static auto total_buffer_size = buffer_base_value * 1024 / (sizeof(T) * num_threads);
     const static auto buffer_size_per_partition = total_buffer_size / partitions;
     std::array<unsigned, partitions> buffer_index = {};
-    std::unique_ptr<T[]> buffer = std::make_unique<T[]>(total_buffer_size);
+    T *buffer = get_worker_buffer<T>(total_buffer_size);
+    uint16_t *partition_ids = get_worker_buffer<uint16_t>(Source::getBatchSize());
 
-    std::array<unsigned, partitions> histogram = {};
-    std::array<std::vector<PageWriteInfo<T>>, partitions> write_info = page_manager.get_write_info(histogram);
-    for (auto [chunk, chunk_size] = tuple_generator.getBatchOfTuples(); chunk; std::tie(chunk, chunk_size) = tuple_generator.getBatchOfTuples()) {
+    std::array<unsigned, partitions> histogram;
+    auto &write_info = get_worker_object<std::array<std::vector<PageWriteInfo<T>>, partitions>>();
+    for (auto &partition_write_info: write_info) {
+        partition_write_info.clear();
+    }
+    for (auto chunk = tuple_source.next_batch(); !chunk.empty(); chunk = tuple_source.next_batch()) {
         histogram.fill(0);
-        for (size_t i = 0; i < chunk_size; ++i) {
-            const size_t partition = partition_function<T, partitions>(chunk[i]);
-            ++histogram[partition];
-        }
-        std::array<std::vector<PageWriteInfo<T>>, partitions> new_write_info = page_manager.get_write_info(histogram);
-        for (size_t i = 0; i < partitions; ++i) {
-            write_info[i].insert(write_info[i].end(), new_write_info[i].cbegin(), new_write_info[i].cend());
+        partition_function_batch<T, partitions, PartitionHash>(chunk.data(), chunk.size(), partition_ids);
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            ++histogram[partition_ids[i]];
         }
+        page_manager.append_write_info(histogram, write_info);
 
-        for (size_t i = 0; i < chunk_size; ++i) {
+        for (size_t i = 0; i < chunk.size(); ++i) {
             const auto &tuple = chunk[i];
-            const size_t partition = partition_function<T, partitions>(tuple);
+            const size_t partition = partition_ids[i];
             auto &index = buffer_index[partition];
             const auto partition_offset = partition * buffer_size_per_partition;
 
             if (index == buffer_size_per_partition) {
-                write_out_buffer_of_partition<T, partitions, page_size>(buffer.get(), write_info, partition, partition_offset, buffer_size_per_partition);
+                write_out_buffer_of_partition<T, partitions, page_size>(buffer, write_info, partition, partition_offset, buffer_size_per_partition);
                 index = 0;
             }
 
@@ -74,7 +78,7 @@ void request_and_process_chunk(HybridPageManager<T, partitions, page_size> &page
     for (size_t i = 0; i < partitions; ++i) {
         if (buffer_index[i] > 0) {
             const auto partition_offset = i * buffer_size_per_partition;
-            write_out_buffer_of_partition<T, partitions, page_size>(buffer.get(), write_info, i, partition_offset, buffer_index[i]);
+            write_out_buffer_of_partition<T, partitions, page_size>(buffer, write_info, i, partition_offset, buffer_index[i]);
             buffer_index[i] = 0;
         }
         if (write_info[i].size() > 0) {
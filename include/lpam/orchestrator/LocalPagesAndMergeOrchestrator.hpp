@@ -2,41 +2,40 @@
 
 #include "lpam/worker/process_morsel_lpam.hpp"
 #include "slotted-page/page-manager/LocalPagesAndMergePageManager.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
 #include <deque>
-#include <thread>
 #include <vector>
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class LocalPagesAndMergeOrchestrator {
     LocalPagesAndMergePageManager<T, partitions, page_size> page_manager;
+    Input input;
     size_t num_tuples;
     size_t num_threads;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit LocalPagesAndMergeOrchestrator(const size_t num_tuples, const size_t num_threads) : page_manager(num_threads), num_tuples(num_tuples), num_threads(num_threads) {
+    explicit LocalPagesAndMergeOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : LocalPagesAndMergeOrchestrator(Input(num_tuples, key_distribution), num_threads) {
     }
 
-    void run() {
-        std::vector<std::thread> threads;
-        threads.reserve(num_threads);
+    LocalPagesAndMergeOrchestrator(Input input, const size_t num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement()) : page_manager(num_threads), input(std::move(input)), num_tuples(this->input.get_num_tuples()), num_threads(num_threads), thread_placement(thread_placement) {
+    }
 
-        std::deque<BatchedTupleGenerator<T>> generators;
+    void run() {
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        std::deque<typename Input::Source> sources;
+        size_t first_tuple = 0;
         for (unsigned i = 0; i < num_threads; i++) {
             const auto tuple_to_generate = num_tuples / num_threads + (i < num_tuples % num_threads);
-            generators.emplace_back(tuple_to_generate);
-            auto &generator = generators.back();
-            threads.emplace_back([this, &generator] {
-                process_morsel_lpam<T, partitions, page_size>(generator, page_manager);
-            });
-        }
-
-        for (auto &thread: threads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
+            sources.emplace_back(input.create_source(first_tuple, tuple_to_generate));
+            first_tuple += tuple_to_generate;
         }
+        WorkerPool::run(cpus, [&](const size_t i) {
+            process_morsel_lpam<T, partitions, page_size, PartitionHash>(sources[i], page_manager);
+        });
     }
     std::vector<size_t> get_written_tuples_per_partition() {
         return page_manager.get_written_tuples_per_partition();
@@ -3,12 +3,12 @@
 
 #include "slotted-page/page-manager/LocalPagesAndMergePageManager.hpp"
 #include "slotted-page/page-manager/OnDemandSingleThreadPageManager.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/TupleSource.hpp"
 #include "util/partitioning_function.hpp"
 
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
-void process_morsel_lpam(BatchedTupleGenerator<T> &tuple_generator, LocalPagesAndMergePageManager<T, partitions, page_size> &page_manager) {
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSource<T> Source>
+void process_morsel_lpam(Source &tuple_source, LocalPagesAndMergePageManager<T, partitions, page_size> &page_manager) {
     OnDemandSingleThreadPageManager<T, partitions, page_size> thread_local_page_manager;
 
     static constexpr unsigned buffer_base_value = partitions <= 32 ? 512 : 2 * 1024;
@@ -16,11 +16,13 @@ void process_morsel_lpam(BatchedTupleGenerator<T> &tuple_generator, LocalPagesAn
     const static auto buffer_size_per_partition = total_buffer_size / partitions;
     std::array<unsigned, partitions> buffer_index = {};
     std::unique_ptr<T[]> buffer = std::make_unique<T[]>(total_buffer_size);
+    std::unique_ptr<uint16_t[]> partition_ids = std::make_unique<uint16_t[]>(Source::getBatchSize());
 
-    for (auto [batch, batch_size] = tuple_generator.getBatchOfTuples(); batch; std::tie(batch, batch_size) = tuple_generator.getBatchOfTuples()) {
-        for (size_t i = 0; i < batch_size; ++i) {
+    for (auto batch = tuple_source.next_batch(); !batch.empty(); batch = tuple_source.next_batch()) {
+        partition_function_batch<T, partitions, PartitionHash>(batch.data(), batch.size(), partition_ids.get());
+        for (size_t i = 0; i < batch.size(); ++i) {
             const auto &tuple = batch[i];
-            const auto partition = partition_function<T, partitions>(tuple);
+            const auto partition = partition_ids[i];
             auto &index = buffer_index[partition];
             const auto partition_offset = partition * buffer_size_per_partition;
 
@@ -1,42 +1,60 @@
 #pragma once
 
-#include <thread>
 #include <vector>
 
+#include "common/morsel-scheduling/ScheduledSource.hpp"
 #include "on-demand/worker/process_morsel.hpp"
 #include "slotted-page/page-manager/OnDemandPageManager.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 #include <deque>
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class OnDemandOrchestrator {
     OnDemandPageManager<T, partitions, page_size> page_manager;
+    Input input;
     size_t num_tuples;
     size_t num_threads;
+    ThreadPlacement thread_placement;
+    MorselDispatch dispatch;
+
+    template<typename Sources>
+    void process_sources(Sources &sources, const std::vector<int> &cpus) {
+        WorkerPool::run(cpus, [&](const size_t i) {
+            process_morsel<T, partitions, page_size, PartitionHash>(sources[i], page_manager);
+        });
+    }
 
 public:
-    explicit OnDemandOrchestrator(size_t num_tuples, size_t num_threads) : num_tuples(num_tuples), num_threads(num_threads) {
+    explicit OnDemandOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : OnDemandOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    OnDemandOrchestrator(Input input, const size_t num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement(), const MorselDispatch dispatch = MorselDispatch::WorkStealing)
+        : input(std::move(input)), num_tuples(this->input.get_num_tuples()), num_threads(num_threads), thread_placement(thread_placement), dispatch(dispatch) {
     }
 
     void run() {
-        std::vector<std::thread> threads;
-        threads.reserve(num_threads);
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        if (dispatch == MorselDispatch::WorkStealing) {
+            MorselScheduler scheduler(num_tuples, num_threads, MorselScheduler::default_morsel_size, Input::Source::getBatchSize());
+            std::vector<ScheduledSource<T, Input>> sources;
+            sources.reserve(num_threads);
+            for (size_t i = 0; i < num_threads; i++) {
+                sources.emplace_back(input, scheduler, i);
+            }
+            process_sources(sources, cpus);
+            return;
+        }
 
-        std::deque<BatchedTupleGenerator<T>> generators;
+        std::deque<typename Input::Source> sources;
+        size_t first_tuple = 0;
         for (unsigned i = 0; i < num_threads; i++) {
             const auto tuple_to_generate = num_tuples / num_threads + (i < num_tuples % num_threads);
-            generators.emplace_back(tuple_to_generate);
-
-            threads.emplace_back([this, i, &generators] {
-                process_morsel<T, partitions, page_size>(generators[i], page_manager);
-            });
-        }
-
-        for (auto &thread: threads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
+            sources.emplace_back(input.create_source(first_tuple, tuple_to_generate));
+            first_tuple += tuple_to_generate;
         }
+        process_sources(sources, cpus);
     }
     std::vector<size_t> get_written_tuples_per_partition() {
         return page_manager.get_written_tuples_per_partition();
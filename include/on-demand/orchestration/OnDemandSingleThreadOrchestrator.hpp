@@ -1,21 +1,25 @@
 #pragma once
 
 #include "slotted-page/page-manager/OnDemandSingleThreadPageManager.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class OnDemandSingleThreadOrchestrator {
-    BatchedTupleGenerator<T> generator;
+    typename Input::Source source;
     OnDemandSingleThreadPageManager<T, partitions, page_size> page_manager;
     size_t num_tuples;
 
 public:
-    explicit OnDemandSingleThreadOrchestrator(size_t num_tuples) : generator(num_tuples), num_tuples(num_tuples) {
+    explicit OnDemandSingleThreadOrchestrator(const size_t num_tuples, const KeyDistribution &key_distribution = {}) : OnDemandSingleThreadOrchestrator(Input(num_tuples, key_distribution)) {
+    }
+
+    explicit OnDemandSingleThreadOrchestrator(const Input &input) : source(input.create_source(0, input.get_num_tuples())), num_tuples(input.get_num_tuples()) {
     }
 
     void run() {
-        for (auto [batch, batch_size] = generator.getBatchOfTuples(); batch; std::tie(batch, batch_size) = generator.getBatchOfTuples()) {
-            for (size_t i = 0; i < batch_size; ++i) {
-                page_manager.insert_tuple(batch[i], partition_function<T, partitions>(batch[i]));
+        for (auto batch = source.next_batch(); !batch.empty(); batch = source.next_batch()) {
+            for (size_t i = 0; i < batch.size(); ++i) {
+                page_manager.insert_tuple(batch[i], partition_function<T, partitions, PartitionHash>(batch[i]));
             }
         }
     }
@@ -1,37 +1,34 @@
 #pragma once
 
 #include <memory>
-#include <thread>
+#include <algorithm>
 #include <vector>
 
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
-template<typename T, size_t batch_size = 2048>
+template<typename T, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class ContinuousMaterialization {
     std::shared_ptr<T[]> data;
+    Input input;
     size_t num_tuples;
     size_t num_threads;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit ContinuousMaterialization(const size_t num_tuples, const unsigned num_threads) : data(std::make_shared<T[]>(num_tuples)), num_tuples(num_tuples), num_threads(num_threads) {}
+    ContinuousMaterialization(Input input, const unsigned num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement())
+        : data(std::make_shared<T[]>(input.get_num_tuples())), input(std::move(input)), num_tuples(this->input.get_num_tuples()), num_threads(num_threads), thread_placement(thread_placement) {}
+
+    // thread i materializes the chunk that thread i of the orchestrator processes, on the same CPU
     void materialize() {
-        size_t current_index = 0;
-        std::vector<std::jthread> threads;
-        threads.reserve(num_threads);
-        for (unsigned i = 0; i < num_threads; i++) {
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        WorkerPool::run(cpus, [&](const size_t i) {
             const size_t current_thread_tuples_to_generate = num_tuples / num_threads + (i < num_tuples % num_threads);
-            threads.emplace_back([this, current_thread_tuples_to_generate, current_index] {
-                auto local_index = current_index;
-                BatchedTupleGenerator<T, batch_size> generator(current_thread_tuples_to_generate);
-                for (size_t j = 0; j < current_thread_tuples_to_generate;) {
-                    auto [batch, local_batch_size] = generator.getBatchOfTuples();
-                    std::memcpy(data.get() + local_index, batch.get(), local_batch_size * sizeof(T));
-                    local_index += local_batch_size;
-                    j += local_batch_size;
-                }
-            });
-            current_index += current_thread_tuples_to_generate;
-        }
+            const size_t current_index = i * (num_tuples / num_threads) + std::min(i, num_tuples % num_threads);
+            auto source = input.create_source(current_index, current_thread_tuples_to_generate);
+            source.fill({data.get() + current_index, current_thread_tuples_to_generate});
+        });
     }
     auto get_data() -> std::shared_ptr<T[]> {
         return data;
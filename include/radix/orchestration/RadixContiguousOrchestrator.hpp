@@ -0,0 +1,51 @@
+#pragma once
+
+#include "radix/output/ContiguousPartitionManager.hpp"
+#include "radix/worker/process_radix_chunk.hpp"
+#include "radix/worker/process_radix_chunk_contiguous.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/make_array.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
+
+// RadixOrchestrator that writes every partition into one exactly sized array instead of slotted pages. Like the
+// RadixOrchestrator every thread fills its chunk itself and releases it while scattering. Every run replaces the
+// partitions of the run before.
+template<typename T, size_t partitions, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
+class RadixContiguousOrchestrator {
+    Input input;
+    ContiguousPartitionManager<T, partitions> partition_manager;
+    size_t num_threads;
+    size_t num_tuples;
+    ThreadPlacement thread_placement;
+
+public:
+    explicit RadixContiguousOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : RadixContiguousOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    RadixContiguousOrchestrator(const Input &input, const size_t num_threads, const PartitionLayout layout = PartitionLayout::Row, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement())
+        : input(input), partition_manager(num_threads, layout), num_threads(num_threads), num_tuples(input.get_num_tuples()), thread_placement(thread_placement) {
+    }
+
+    void run() {
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        WorkerPool::run(cpus, [&](const size_t i) {
+            const size_t chunk_size = num_tuples / num_threads + (i < num_tuples % num_threads);
+            const size_t first_tuple = i * (num_tuples / num_threads) + std::min(i, num_tuples % num_threads);
+            auto source = input.create_source(first_tuple, chunk_size);
+            const std::unique_ptr<T[]> chunk = make_array_for_overwrite<T>(chunk_size);
+            const std::unique_ptr<uint16_t[]> partition_ids = make_array_for_overwrite<uint16_t>(chunk_size);
+            std::array<unsigned, partitions> histogram = {};
+            fill_radix_chunk<T, partitions, PartitionHash>(source, chunk.get(), chunk_size, partition_ids.get(), histogram);
+            scatter_radix_chunk_contiguous<T, partitions>(partition_manager, chunk.get(), partition_ids.get(), histogram, chunk_size, num_threads, true);
+        });
+    }
+
+    std::vector<size_t> get_written_tuples_per_partition() {
+        return partition_manager.get_written_tuples_per_partition();
+    }
+
+    ContiguousPartitionManager<T, partitions> &get_partition_manager() {
+        return partition_manager;
+    }
+};
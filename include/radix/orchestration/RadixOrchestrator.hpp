@@ -1,35 +1,42 @@
 #pragma once
 
-#include "radix/materialization/ContiniousMaterialization.hpp"
 #include "radix/worker/process_radix_chunk.hpp"
 #include "slotted-page/page-manager/RadixPageManager.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/make_array.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+// Every thread generates or reads its chunk into memory of its own, computing the histogram on the way, and scatters
+// it right away. There is no separate materialization pass and the chunk is released while it is scattered.
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class RadixOrchestrator {
-    ContinuousMaterialization<T> materialization;
+    Input input;
     RadixPageManager<T, partitions, page_size> page_manager;
     size_t num_threads;
     size_t num_tuples;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit RadixOrchestrator(const size_t num_tuples, const size_t num_threads) : materialization(num_tuples, num_threads), page_manager(num_threads), num_threads(num_threads), num_tuples(num_tuples) {
+    explicit RadixOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : RadixOrchestrator(Input(num_tuples, key_distribution), num_threads) {
     }
 
-    void run() {
-        materialization.materialize();
-        const auto data = materialization.get_data();
-        std::vector<std::jthread> threads;
-        threads.reserve(num_threads);
+    RadixOrchestrator(const Input &input, const size_t num_threads, const NumaPlacement placement = NumaPlacement::None, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement(), const HistogramMerge merge = HistogramMerge::Locking)
+        : input(input), page_manager(num_threads, placement, merge), num_threads(num_threads), num_tuples(input.get_num_tuples()), thread_placement(thread_placement) {
+    }
 
-        auto current_index = 0;
-        for (size_t i = 0; i < num_threads; ++i) {
+    void run() {
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        WorkerPool::run(cpus, [&](const size_t i) {
             const size_t chunk_size = num_tuples / num_threads + (i < num_tuples % num_threads);
-            const auto raw_pointer = data.get();
-            threads.emplace_back([this, raw_pointer, current_index, chunk_size]() {
-                process_radix_chunk<T, partitions>(page_manager, raw_pointer + current_index, chunk_size, num_threads);
-            });
-            current_index += chunk_size;
-        }
+            const size_t first_tuple = i * (num_tuples / num_threads) + std::min(i, num_tuples % num_threads);
+            auto source = input.create_source(first_tuple, chunk_size);
+            const std::unique_ptr<T[]> chunk = make_array_for_overwrite<T>(chunk_size);
+            const std::unique_ptr<uint16_t[]> partition_ids = make_array_for_overwrite<uint16_t>(chunk_size);
+            std::array<unsigned, partitions> histogram = {};
+            fill_radix_chunk<T, partitions, PartitionHash>(source, chunk.get(), chunk_size, partition_ids.get(), histogram);
+            scatter_radix_chunk<T, partitions, page_size>(page_manager, chunk.get(), partition_ids.get(), histogram, chunk_size, num_threads, true);
+        });
     }
 
     std::vector<size_t> get_written_tuples_per_partition() {
@@ -4,38 +4,31 @@
 #include "radix/worker/process_radix_chunk_selectively.hpp"
 #include "slotted-page/page-manager/RadixPageManager.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, size_t k = 32>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, size_t k = 32, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class RadixSelectiveOrchestrator {
-    ContinuousMaterialization<T> materialization;
+    ContinuousMaterialization<T, Input> materialization;
     RadixPageManager<T, partitions, page_size> page_manager;
     size_t num_threads;
     size_t num_tuples;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit RadixSelectiveOrchestrator(const size_t num_tuples, const size_t num_threads) : materialization(num_tuples, num_threads), page_manager(num_threads), num_threads(num_threads), num_tuples(num_tuples) {
+    explicit RadixSelectiveOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : RadixSelectiveOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    RadixSelectiveOrchestrator(const Input &input, const size_t num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement(), const HistogramMerge merge = HistogramMerge::Locking)
+        : materialization(input, num_threads, thread_placement), page_manager(num_threads, NumaPlacement::None, merge), num_threads(num_threads), num_tuples(input.get_num_tuples()), thread_placement(thread_placement) {
     }
 
     void run() {
         materialization.materialize();
         const auto data = materialization.get_data();
-        std::vector<std::thread> threads;
-        threads.reserve(num_threads);
-
-        auto current_index = 0;
-        for (size_t i = 0; i < num_threads; ++i) {
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        WorkerPool::run(cpus, [&](const size_t i) {
             const size_t chunk_size = num_tuples / num_threads + (i < num_tuples % num_threads);
-            const auto raw_pointer = data.get();
-            threads.emplace_back([this, raw_pointer, current_index, chunk_size] {
-                process_radix_chunk_selectively<T, partitions, k>(page_manager, raw_pointer + current_index, chunk_size);
-            });
-            current_index += chunk_size;
-        }
-
-        for (auto &thread: threads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
-        }
+            const size_t first_tuple = i * (num_tuples / num_threads) + std::min(i, num_tuples % num_threads);
+            process_radix_chunk_selectively<T, partitions, k, page_size, PartitionHash>(page_manager, data.get() + first_tuple, chunk_size);
+        });
     }
 
     std::vector<size_t> get_written_tuples_per_partition() {
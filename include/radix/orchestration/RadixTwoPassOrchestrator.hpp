@@ -0,0 +1,37 @@
+#pragma once
+
+#include "radix/materialization/ContiniousMaterialization.hpp"
+#include "radix/worker/process_radix_chunk_two_pass.hpp"
+#include "slotted-page/page-manager/RadixPageManager.hpp"
+
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
+class RadixTwoPassOrchestrator {
+    ContinuousMaterialization<T, Input> materialization;
+    RadixPageManager<T, partitions, page_size> page_manager;
+    size_t num_threads;
+    size_t num_tuples;
+    ThreadPlacement thread_placement;
+
+public:
+    explicit RadixTwoPassOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : RadixTwoPassOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    RadixTwoPassOrchestrator(const Input &input, const size_t num_threads, const NumaPlacement placement = NumaPlacement::None, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement(), const HistogramMerge merge = HistogramMerge::Locking)
+        : materialization(input, num_threads, thread_placement), page_manager(num_threads, placement, merge), num_threads(num_threads), num_tuples(input.get_num_tuples()), thread_placement(thread_placement) {
+    }
+
+    void run() {
+        materialization.materialize();
+        const auto data = materialization.get_data();
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        WorkerPool::run(cpus, [&](const size_t i) {
+            const size_t chunk_size = num_tuples / num_threads + (i < num_tuples % num_threads);
+            const size_t first_tuple = i * (num_tuples / num_threads) + std::min(i, num_tuples % num_threads);
+            process_radix_chunk_two_pass<T, partitions, page_size, PartitionHash>(page_manager, data.get() + first_tuple, chunk_size);
+        });
+    }
+
+    std::vector<size_t> get_written_tuples_per_partition() {
+        return page_manager.get_written_tuples_per_partition();
+    }
+};
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+// How the tuples of a partition are stored in its contiguous array.
+enum class PartitionLayout {
+    // the tuples one after another
+    Row,
+    // all keys first, then the variable data of all tuples in the same order
+    Pax,
+};
+
+inline const char *get_partition_layout_name(const PartitionLayout layout) {
+    switch (layout) {
+        case PartitionLayout::Row:
+            return "row";
+        case PartitionLayout::Pax:
+            return "pax";
+    }
+    return "unknown";
+}
+
+// Output of the radix orchestrators without slotted pages: every partition is a single array of exactly the size of
+// its histogram. All threads add their chunk histograms at once, meet at a barrier and every thread sums up and
+// allocates a share of the partitions. Every thread gets a disjoint range per partition, so tuples are written
+// without locks and the result holds no slot headers.
+template<typename T, size_t partitions>
+class ContiguousPartitionManager {
+    using KeyType = typename T::KeyType;
+    static constexpr size_t variable_size = T::get_size_of_variable_data();
+
+    size_t num_threads;
+    PartitionLayout layout;
+    std::atomic<size_t> next_slot = 0;
+    std::barrier<> merge_barrier;
+    // indexed by the slot a thread draws in add_histogram_chunk
+    std::vector<unsigned> slot_histograms;
+    std::vector<size_t> slot_offsets;
+    std::vector<std::unique_ptr<uint8_t[]>> partition_data;
+    std::vector<size_t> partition_sizes;
+
+    [[nodiscard]] size_t get_tuple_bytes() const {
+        return layout == PartitionLayout::Row ? sizeof(T) : sizeof(KeyType) + variable_size;
+    }
+
+    // partitions [first_partition, last_partition) are summed up and allocated by one thread
+    void allocate_partitions(const size_t first_partition, const size_t last_partition) {
+        for (size_t partition = first_partition; partition < last_partition; ++partition) {
+            size_t size = 0;
+            for (size_t slot = 0; slot < num_threads; ++slot) {
+                slot_offsets[slot * partitions + partition] = size;
+                size += slot_histograms[slot * partitions + partition];
+            }
+            partition_sizes[partition] = size;
+            partition_data[partition] = std::make_unique_for_overwrite<uint8_t[]>(size * get_tuple_bytes());
+        }
+    }
+
+public:
+    ContiguousPartitionManager(const size_t num_threads, const PartitionLayout layout = PartitionLayout::Row)
+        : num_threads(num_threads), layout(layout), merge_barrier(static_cast<std::ptrdiff_t>(num_threads)), slot_histograms(num_threads * partitions),
+          slot_offsets(num_threads * partitions), partition_data(partitions), partition_sizes(partitions, 0) {
+    }
+
+    // Has to be called by all num_threads threads exactly once per round, returns the index of the first tuple of the
+    // calling thread in every partition. A later round replaces the partitions of the previous one.
+    std::vector<size_t> add_histogram_chunk(const std::array<unsigned, partitions> &local_histogram) {
+        const size_t slot = next_slot.fetch_add(1) % num_threads;
+        std::copy(local_histogram.begin(), local_histogram.end(), slot_histograms.begin() + slot * partitions);
+        merge_barrier.arrive_and_wait();
+        allocate_partitions(slot * partitions / num_threads, (slot + 1) * partitions / num_threads);
+        merge_barrier.arrive_and_wait();
+        return {slot_offsets.begin() + slot * partitions, slot_offsets.begin() + (slot + 1) * partitions};
+    }
+
+    // stores the tuples at the indices [first_index, first_index + num_tuples) of the partition
+    void write_tuples(const size_t partition, const size_t first_index, const T *tuples, const size_t num_tuples) {
+        if (layout == PartitionLayout::Row) {
+            std::memcpy(partition_data[partition].get() + first_index * sizeof(T), tuples, num_tuples * sizeof(T));
+            return;
+        }
+        const auto keys = get_keys(partition);
+        for (size_t i = 0; i < num_tuples; ++i) {
+            keys[first_index + i] = tuples[i].get_key();
+        }
+        if constexpr (variable_size > 0) {
+            auto *variable_data = get_variable_data(partition) + first_index * variable_size;
+            for (size_t i = 0; i < num_tuples; ++i) {
+                std::memcpy(variable_data + i * variable_size, &tuples[i].get_variable_data(), variable_size);
+            }
+        }
+    }
+
+    [[nodiscard]] PartitionLayout get_layout() const {
+        return layout;
+    }
+
+    // PartitionLayout::Row
+    std::span<T> get_rows(const size_t partition) {
+        return {reinterpret_cast<T *>(partition_data[partition].get()), partition_sizes[partition]};
+    }
+
+    // PartitionLayout::Pax, the key column of the partition
+    std::span<KeyType> get_keys(const size_t partition) {
+        return {reinterpret_cast<KeyType *>(partition_data[partition].get()), partition_sizes[partition]};
+    }
+
+    // PartitionLayout::Pax, the variable data of tuple i starts at i * T::get_size_of_variable_data()
+    uint8_t *get_variable_data(const size_t partition) {
+        return partition_data[partition].get() + partition_sizes[partition] * sizeof(KeyType);
+    }
+
+    std::vector<size_t> get_written_tuples_per_partition() const {
+        return partition_sizes;
+    }
+
+    std::vector<std::vector<T>> get_all_tuples_per_partition() {
+        std::vector<std::vector<T>> result(partitions);
+        for (size_t partition = 0; partition < partitions; ++partition) {
+            if (layout == PartitionLayout::Row) {
+                const auto rows = get_rows(partition);
+                result[partition].assign(rows.begin(), rows.end());
+                continue;
+            }
+            const auto keys = get_keys(partition);
+            for (size_t i = 0; i < keys.size(); ++i) {
+                if constexpr (variable_size > 0) {
+                    std::array<uint32_t, variable_size / sizeof(uint32_t)> tuple_data;
+                    std::memcpy(tuple_data.data(), get_variable_data(partition) + i * variable_size, variable_size);
+                    result[partition].emplace_back(keys[i], tuple_data);
+                } else {
+                    result[partition].emplace_back(keys[i]);
+                }
+            }
+        }
+        return result;
+    }
+};
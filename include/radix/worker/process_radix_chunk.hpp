@@ -1,16 +1,33 @@
 #pragma once
 
+#include "hybrid/worker/request_and_process_chunk.hpp"
 #include "slotted-page/page-manager/PageWriteInfo.hpp"
 #include "slotted-page/page-manager/RadixPageManager.hpp"
+#include "tuple-source/TupleSource.hpp"
 #include "util/partitioning_function.hpp"
+#include "util/release_memory.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
-void process_radix_chunk(RadixPageManager<T, partitions, page_size> &page_manager, T *chunk, const size_t chunk_size, const size_t num_threads) {
-    std::array<unsigned, partitions> histogram = {};
-    for (size_t i = 0; i < chunk_size; ++i) {
-        const size_t partition = partition_function<T, partitions>(chunk[i]);
-        ++histogram[partition];
+// Generates or reads the chunk and computes its partition ids and histogram in the same pass, one batch of the source
+// at a time while it is still in the cache.
+template<typename T, size_t partitions, typename PartitionHash = IdentityHash, TupleSource<T> Source>
+void fill_radix_chunk(Source &source, T *chunk, const size_t chunk_size, uint16_t *partition_ids, std::array<unsigned, partitions> &histogram) {
+    for (size_t filled = 0; filled < chunk_size;) {
+        const size_t length = source.fill({chunk + filled, std::min<size_t>(Source::getBatchSize(), chunk_size - filled)});
+        if (length == 0) {
+            break;
+        }
+        partition_function_batch<T, partitions, PartitionHash>(chunk + filled, length, partition_ids + filled);
+        for (size_t i = filled; i < filled + length; ++i) {
+            ++histogram[partition_ids[i]];
+        }
+        filled += length;
     }
+}
+
+// Writes the chunk into the pages of the page manager. With release_input the chunk and its partition ids are handed
+// back to the kernel while they are consumed, so the input shrinks while the partitions grow.
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+void scatter_radix_chunk(RadixPageManager<T, partitions, page_size> &page_manager, const T *chunk, const uint16_t *partition_ids, const std::array<unsigned, partitions> &histogram, const size_t chunk_size, const size_t num_threads, const bool release_input = false) {
     std::array<std::vector<PageWriteInfo<T>>, partitions> write_info = page_manager.add_histogram_chunk(histogram);
 
     static constexpr unsigned buffer_base_value = 2 * 1024;
@@ -19,10 +36,12 @@ void process_radix_chunk(RadixPageManager<T, partitions, page_size> &page_manage
     std::array<unsigned, partitions> buffer_index = {};
     std::unique_ptr<T[]> buffer = std::make_unique<T[]>(total_buffer_size);
 
+    static constexpr size_t release_interval = 2 * 1024 * 1024 / sizeof(T);
+    size_t released_tuples = 0;
 
     for (size_t i = 0; i < chunk_size; ++i) {
         const auto &tuple = chunk[i];
-        const size_t partition = partition_function<T, partitions>(tuple);
+        const size_t partition = partition_ids[i];
         auto &index = buffer_index[partition];
         const auto partition_offset = partition * buffer_size_per_partition;
 
@@ -33,6 +52,12 @@ void process_radix_chunk(RadixPageManager<T, partitions, page_size> &page_manage
 
         buffer[partition_offset + index] = tuple;
         ++index;
+
+        if (release_input && i + 1 - released_tuples == release_interval) {
+            release_memory_range(chunk + released_tuples, chunk + i + 1);
+            release_memory_range(partition_ids + released_tuples, partition_ids + i + 1);
+            released_tuples = i + 1;
+        }
     }
 
     for (size_t i = 0; i < partitions; ++i) {
@@ -47,4 +72,15 @@ void process_radix_chunk(RadixPageManager<T, partitions, page_size> &page_manage
             }
         }
     }
-}
\ No newline at end of file
+}
+
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash>
+void process_radix_chunk(RadixPageManager<T, partitions, page_size> &page_manager, T *chunk, const size_t chunk_size, const size_t num_threads) {
+    std::array<unsigned, partitions> histogram = {};
+    std::unique_ptr<uint16_t[]> partition_ids = std::make_unique_for_overwrite<uint16_t[]>(chunk_size);
+    partition_function_batch<T, partitions, PartitionHash>(chunk, chunk_size, partition_ids.get());
+    for (size_t i = 0; i < chunk_size; ++i) {
+        ++histogram[partition_ids[i]];
+    }
+    scatter_radix_chunk<T, partitions, page_size>(page_manager, chunk, partition_ids.get(), histogram, chunk_size, num_threads);
+}
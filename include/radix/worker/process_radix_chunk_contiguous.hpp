@@ -0,0 +1,60 @@
+#pragma once
+
+#include "radix/output/ContiguousPartitionManager.hpp"
+#include "util/partitioning_function.hpp"
+#include "util/release_memory.hpp"
+
+// scatter_radix_chunk for the contiguous output, the ranges are known after the histogram merge so the buffer of a
+// partition is flushed with a plain copy to the next free index of the thread. With release_input the chunk and its
+// partition ids are handed back to the kernel while they are consumed.
+template<typename T, size_t partitions>
+void scatter_radix_chunk_contiguous(ContiguousPartitionManager<T, partitions> &partition_manager, const T *chunk, const uint16_t *partition_ids, const std::array<unsigned, partitions> &histogram, const size_t chunk_size, const size_t num_threads, const bool release_input = false) {
+    std::vector<size_t> next_index = partition_manager.add_histogram_chunk(histogram);
+
+    static constexpr unsigned buffer_base_value = 2 * 1024;
+    // at least one tuple per partition, otherwise the buffers of the partitions overlap
+    const auto buffer_size_per_partition = std::max<size_t>(buffer_base_value * 1024 / (sizeof(T) * num_threads) / partitions, 1);
+    std::array<unsigned, partitions> buffer_index = {};
+    std::unique_ptr<T[]> buffer = std::make_unique_for_overwrite<T[]>(buffer_size_per_partition * partitions);
+
+    static constexpr size_t release_interval = 2 * 1024 * 1024 / sizeof(T);
+    size_t released_tuples = 0;
+
+    for (size_t i = 0; i < chunk_size; ++i) {
+        const size_t partition = partition_ids[i];
+        auto &index = buffer_index[partition];
+        const auto partition_offset = partition * buffer_size_per_partition;
+
+        if (index == buffer_size_per_partition) {
+            partition_manager.write_tuples(partition, next_index[partition], buffer.get() + partition_offset, index);
+            next_index[partition] += index;
+            index = 0;
+        }
+
+        buffer[partition_offset + index] = chunk[i];
+        ++index;
+
+        if (release_input && i + 1 - released_tuples == release_interval) {
+            release_memory_range(chunk + released_tuples, chunk + i + 1);
+            release_memory_range(partition_ids + released_tuples, partition_ids + i + 1);
+            released_tuples = i + 1;
+        }
+    }
+
+    for (size_t partition = 0; partition < partitions; ++partition) {
+        if (buffer_index[partition] > 0) {
+            partition_manager.write_tuples(partition, next_index[partition], buffer.get() + partition * buffer_size_per_partition, buffer_index[partition]);
+        }
+    }
+}
+
+template<typename T, size_t partitions, typename PartitionHash = IdentityHash>
+void process_radix_chunk_contiguous(ContiguousPartitionManager<T, partitions> &partition_manager, T *chunk, const size_t chunk_size, const size_t num_threads) {
+    std::array<unsigned, partitions> histogram = {};
+    std::unique_ptr<uint16_t[]> partition_ids = std::make_unique_for_overwrite<uint16_t[]>(chunk_size);
+    partition_function_batch<T, partitions, PartitionHash>(chunk, chunk_size, partition_ids.get());
+    for (size_t i = 0; i < chunk_size; ++i) {
+        ++histogram[partition_ids[i]];
+    }
+    scatter_radix_chunk_contiguous<T, partitions>(partition_manager, chunk, partition_ids.get(), histogram, chunk_size, num_threads);
+}
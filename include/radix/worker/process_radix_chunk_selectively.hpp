@@ -5,12 +5,13 @@
 #include "util/partitioning_function.hpp"
 
 
-template<typename T, size_t partitions, size_t k, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t k, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash>
 void process_radix_chunk_selectively(RadixPageManager<T, partitions, page_size> &page_manager, T *chunk, size_t chunk_size) {
     std::array<unsigned, partitions> histogram = {};
+    std::unique_ptr<uint16_t[]> partition_ids = std::make_unique_for_overwrite<uint16_t[]>(chunk_size);
+    partition_function_batch<T, partitions, PartitionHash>(chunk, chunk_size, partition_ids.get());
     for (size_t i = 0; i < chunk_size; ++i) {
-        const size_t partition = partition_function<T, partitions>(chunk[i]);
-        ++histogram[partition];
+        ++histogram[partition_ids[i]];
     }
 
     auto write_info = page_manager.add_histogram_chunk(histogram);
@@ -23,7 +24,7 @@ void process_radix_chunk_selectively(RadixPageManager<T, partitions, page_size>
             const size_t end_partition = std::min(start_partition + k, partitions);
 
             for (unsigned i = 0; i < std::min(chunk_size - start_offset, inner_loop_size); ++i) {
-                const size_t partition = partition_function<T, partitions>(chunk[start_offset + i]);
+                const size_t partition = partition_ids[start_offset + i];
 
                 // Check if current partition is within the k-block we're processing
                 if (partition >= start_partition && partition < end_partition) {
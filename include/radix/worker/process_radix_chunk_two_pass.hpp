@@ -0,0 +1,81 @@
+#pragma once
+
+#include "hybrid/worker/request_and_process_chunk.hpp"
+#include "slotted-page/page-manager/PageWriteInfo.hpp"
+#include "slotted-page/page-manager/RadixPageManager.hpp"
+#include "util/partitioning_function.hpp"
+
+// smallest fan-out f with f * f >= partitions, so both passes scatter into at most sqrt(partitions) ranges
+consteval size_t get_first_pass_fanout(const size_t partitions) {
+    size_t fanout = 1;
+    while (fanout * fanout < partitions) {
+        ++fanout;
+    }
+    return fanout;
+}
+
+// Partitions the chunk in two scatter passes instead of one with the full fan-out. The first pass moves every tuple
+// into one of get_first_pass_fanout(partitions) buckets of neighbouring partitions, the second pass orders each bucket
+// by partition, so every pass writes to few enough locations to stay within the cache and the TLB. Afterwards the
+// tuples of a partition are contiguous and go to the pages in one batch. The histogram of the final partitions is
+// known after the partition ids are computed, so the pages are requested once per chunk, like in process_radix_chunk.
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash>
+void process_radix_chunk_two_pass(RadixPageManager<T, partitions, page_size> &page_manager, T *chunk, const size_t chunk_size) {
+    static constexpr size_t buckets = get_first_pass_fanout(partitions);
+    static constexpr size_t partitions_per_bucket = (partitions + buckets - 1) / buckets;
+
+    std::unique_ptr<uint16_t[]> partition_ids = std::make_unique_for_overwrite<uint16_t[]>(chunk_size);
+    partition_function_batch<T, partitions, PartitionHash>(chunk, chunk_size, partition_ids.get());
+    std::array<unsigned, partitions> histogram = {};
+    for (size_t i = 0; i < chunk_size; ++i) {
+        ++histogram[partition_ids[i]];
+    }
+    std::array<std::vector<PageWriteInfo<T>>, partitions> write_info = page_manager.add_histogram_chunk(histogram);
+
+    // first pass, bucket b holds the partitions [b * partitions_per_bucket, (b + 1) * partitions_per_bucket)
+    std::array<size_t, buckets + 1> bucket_begin = {};
+    for (size_t partition = 0; partition < partitions; ++partition) {
+        bucket_begin[partition / partitions_per_bucket + 1] += histogram[partition];
+    }
+    for (size_t b = 0; b < buckets; ++b) {
+        bucket_begin[b + 1] += bucket_begin[b];
+    }
+    std::unique_ptr<T[]> bucketed = std::make_unique_for_overwrite<T[]>(chunk_size);
+    std::unique_ptr<uint16_t[]> bucketed_ids = std::make_unique_for_overwrite<uint16_t[]>(chunk_size);
+    std::array<size_t, buckets> bucket_fill;
+    std::copy_n(bucket_begin.begin(), buckets, bucket_fill.begin());
+    for (size_t i = 0; i < chunk_size; ++i) {
+        const auto position = bucket_fill[partition_ids[i] / partitions_per_bucket]++;
+        bucketed[position] = chunk[i];
+        bucketed_ids[position] = partition_ids[i];
+    }
+    partition_ids.reset();
+
+    // second pass, the partitions of a bucket reuse one buffer that holds the largest bucket
+    size_t largest_bucket = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        largest_bucket = std::max(largest_bucket, bucket_begin[b + 1] - bucket_begin[b]);
+    }
+    std::unique_ptr<T[]> ordered = std::make_unique_for_overwrite<T[]>(largest_bucket);
+    std::array<unsigned, partitions_per_bucket + 1> partition_begin;
+    for (size_t b = 0; b < buckets; ++b) {
+        const size_t first_partition = b * partitions_per_bucket;
+        const size_t bucket_partitions = std::min(partitions_per_bucket, partitions - std::min(partitions, first_partition));
+        partition_begin[0] = 0;
+        for (size_t p = 0; p < bucket_partitions; ++p) {
+            partition_begin[p + 1] = partition_begin[p] + histogram[first_partition + p];
+        }
+        std::array<unsigned, partitions_per_bucket> partition_fill;
+        std::copy_n(partition_begin.begin(), bucket_partitions, partition_fill.begin());
+        for (size_t i = bucket_begin[b]; i < bucket_begin[b + 1]; ++i) {
+            ordered[partition_fill[bucketed_ids[i] - first_partition]++] = bucketed[i];
+        }
+
+        // every page range of the chunk is filled completely, so write_out also sets the tuple counts
+        for (size_t p = 0; p < bucket_partitions; ++p) {
+            if (histogram[first_partition + p] > 0) {
+                write_out_buffer_of_partition<T, partitions, page_size>(ordered.get(), write_info, first_partition + p, partition_begin[p], histogram[first_partition + p]);
+            }
+        }
+    }
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "shuffle-operator/ShuffleOperator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/make_array.hpp"
+#include "util/partitioning_function.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+// What the cost model knows about a micro-batch before it is shuffled.
+struct ShuffleSample {
+    size_t tuple_size = sizeof(Tuple16);
+    size_t partitions = 32;
+    size_t num_threads = 1;
+    // share of the largest partition times the partition count, 1 for evenly spread keys
+    double skew = 1;
+};
+
+// Estimated cost per tuple of every algorithm. The single-threaded part of the priors is fitted to a calibration run
+// (see get_prior), the contention on hot partitions of the algorithms with shared pages is an estimate. A measured
+// micro-batch scales the prior of its algorithm, algorithms that were not measured yet use the mean scale of the
+// measured ones.
+class ShuffleCostModel {
+public:
+    static constexpr size_t num_algorithms = 5;
+
+private:
+    // moving average of measured / prior, 0 if the algorithm was not measured yet
+    std::array<double, num_algorithms> corrections = {};
+    static constexpr double smoothing = 0.5;
+
+    // threads that queue behind the writer of the hottest partition
+    static double get_contention(const ShuffleSample &sample) {
+        return std::min(sample.skew, static_cast<double>(sample.num_threads)) - 1;
+    }
+
+    [[nodiscard]] double get_default_correction() const {
+        double sum = 0;
+        size_t measured = 0;
+        for (const auto correction: corrections) {
+            if (correction > 0) {
+                sum += correction;
+                ++measured;
+            }
+        }
+        return measured == 0 ? 1 : sum / static_cast<double>(measured);
+    }
+
+public:
+    // ns per tuple of one thread. The linear terms are a least-squares fit (relative error) to two single-threaded
+    // ShuffleOperator runs on one AVX-512 core with uniform keys, 4, 16 and 100 byte tuples and 32 to 4096 partitions,
+    // the median error is 13%. The skew and thread factors were not measured, the calibration machine had one core,
+    // they only order the algorithms by how much of their work queues behind a hot partition.
+    static double get_prior(const ShuffleAlgorithm algorithm, const ShuffleSample &sample) {
+        const auto partitions = static_cast<double>(sample.partitions);
+        const auto bytes = static_cast<double>(sample.tuple_size);
+        const auto contention = get_contention(sample);
+        switch (algorithm) {
+            case ShuffleAlgorithm::Smb:
+                return (3.7 + 0.0030 * partitions + 0.79 * bytes) * (1 + 0.4 * contention);
+            case ShuffleAlgorithm::Radix:
+                return 4.8 + 0.0030 * partitions + 1.42 * bytes;
+            case ShuffleAlgorithm::Hybrid:
+                return (3.7 + 0.0083 * partitions + 0.77 * bytes) * (1 + 0.07 * contention);
+            case ShuffleAlgorithm::LocalPagesAndMerge:
+                return 2.75 + 0.0034 * partitions + 0.69 * bytes;
+            case ShuffleAlgorithm::CollaborativeMorselProcessing:
+                // every worker reads the whole input
+                return (4.6 + 0.0032 * partitions + 0.82 * bytes) * (1 + 0.04 * static_cast<double>(sample.num_threads - 1));
+        }
+        return 0;
+    }
+
+    [[nodiscard]] double estimate(const ShuffleAlgorithm algorithm, const ShuffleSample &sample) const {
+        const auto correction = corrections[static_cast<size_t>(algorithm)];
+        return get_prior(algorithm, sample) * (correction > 0 ? correction : get_default_correction());
+    }
+
+    void observe(const ShuffleAlgorithm algorithm, const ShuffleSample &sample, const double ns_per_tuple) {
+        auto &correction = corrections[static_cast<size_t>(algorithm)];
+        const auto measured = ns_per_tuple / get_prior(algorithm, sample);
+        correction = correction > 0 ? smoothing * measured + (1 - smoothing) * correction : measured;
+    }
+
+    [[nodiscard]] bool is_measured(const ShuffleAlgorithm algorithm) const {
+        return corrections[static_cast<size_t>(algorithm)] > 0;
+    }
+
+    // the algorithms ordered by their estimated cost, cheapest first
+    [[nodiscard]] std::array<ShuffleAlgorithm, num_algorithms> rank(const ShuffleSample &sample) const {
+        std::array<ShuffleAlgorithm, num_algorithms> algorithms = {ShuffleAlgorithm::Smb, ShuffleAlgorithm::Radix, ShuffleAlgorithm::Hybrid,
+                                                                   ShuffleAlgorithm::LocalPagesAndMerge, ShuffleAlgorithm::CollaborativeMorselProcessing};
+        std::ranges::stable_sort(algorithms, {}, [&](const ShuffleAlgorithm algorithm) { return estimate(algorithm, sample); });
+        return algorithms;
+    }
+};
+
+// Runs a stream of micro-batches with the algorithm the cost model expects to be the cheapest. Before every batch the
+// first morsels of its input are partitioned to measure the skew, after the batch its throughput is fed back into the
+// model, so a later batch switches to another algorithm once the measurements contradict the priors. Every
+// exploration_interval batches the runner-up is run once instead, otherwise an algorithm whose prior is too pessimistic
+// is never measured. Outside of the precompiled configurations only the generic SMB path can run, so the choice, the
+// exploration and the calibration are limited to SMB there. AdaptiveShuffleOrchestrator precompiles partition counts up
+// to 4096, so that every algorithm competes for the wide shuffles too.
+template<size_t... precompiled_partitions>
+class BasicAdaptiveShuffleOrchestrator {
+    // enough tuples that sampling noise does not look like skew
+    static constexpr size_t sample_tuples_per_partition = 64;
+
+    ShuffleOperatorConfig config;
+    size_t exploration_interval;
+    ShuffleCostModel model;
+    ShuffleSample last_sample;
+    ShuffleAlgorithm last_algorithm = ShuffleAlgorithm::Smb;
+    size_t batches = 0;
+
+    template<typename T>
+    double sample_skew(const size_t num_tuples, const uint64_t seed) const {
+        // the relation BasicShuffleOperator::run(num_tuples, seed) shuffles
+        using Input = GeneratedRelation<T>;
+        const Input input(num_tuples, config.key_distribution, seed);
+        const size_t batch_size = Input::Source::getBatchSize();
+        const size_t sample_size = std::min(num_tuples, (config.partitions * sample_tuples_per_partition + batch_size - 1) / batch_size * batch_size);
+        if (sample_size == 0) {
+            return 1;
+        }
+        auto source = input.create_source(0, sample_size);
+        const auto tuples = make_array_for_overwrite<T>(sample_size);
+        size_t sampled = 0;
+        while (sampled < sample_size) {
+            const auto filled = source.fill({tuples.get() + sampled, sample_size - sampled});
+            if (filled == 0) {
+                break;
+            }
+            sampled += filled;
+        }
+
+        const RuntimePartitionFunction partition_function(config.partitions);
+        std::vector<size_t> histogram(config.partitions, 0);
+        for (size_t i = 0; i < sampled; ++i) {
+            ++histogram[partition_function(tuples[i])];
+        }
+        const auto largest = static_cast<double>(std::ranges::max(histogram));
+        return std::max(1.0, largest * static_cast<double>(config.partitions) / static_cast<double>(sampled));
+    }
+
+    ShuffleSample take_sample(const size_t num_tuples, const uint64_t seed) const {
+        ShuffleSample sample{.partitions = config.partitions, .num_threads = config.num_threads};
+        switch (config.tuple_layout) {
+            case TupleLayout::Tuple4:
+                sample.tuple_size = sizeof(Tuple4);
+                sample.skew = sample_skew<Tuple4>(num_tuples, seed);
+                break;
+            case TupleLayout::Tuple16:
+                sample.tuple_size = sizeof(Tuple16);
+                sample.skew = sample_skew<Tuple16>(num_tuples, seed);
+                break;
+            case TupleLayout::Tuple100:
+                sample.tuple_size = sizeof(Tuple100);
+                sample.skew = sample_skew<Tuple100>(num_tuples, seed);
+                break;
+        }
+        return sample;
+    }
+
+    // the generic path of BasicShuffleOperator runs SMB for every algorithm
+    [[nodiscard]] bool is_runnable(const ShuffleAlgorithm algorithm) const {
+        ShuffleOperatorConfig algorithm_config = config;
+        algorithm_config.algorithm = algorithm;
+        return BasicShuffleOperator<precompiled_partitions...>(algorithm_config).get_algorithm() == algorithm;
+    }
+
+    // the algorithms that can run with the configuration, cheapest first
+    std::vector<ShuffleAlgorithm> rank_runnable(const ShuffleSample &sample) const {
+        std::vector<ShuffleAlgorithm> ranking;
+        for (const auto algorithm: model.rank(sample)) {
+            if (is_runnable(algorithm)) {
+                ranking.push_back(algorithm);
+            }
+        }
+        return ranking;
+    }
+
+    ShuffleAlgorithm choose_algorithm(const ShuffleSample &sample) const {
+        const auto ranking = rank_runnable(sample);
+        const bool explore = exploration_interval > 1 && batches % exploration_interval == exploration_interval - 1;
+        return explore && ranking.size() > 1 ? ranking[1] : ranking[0];
+    }
+
+public:
+    // exploration_interval 0 disables the exploration, 1 would never run the cheapest algorithm
+    explicit BasicAdaptiveShuffleOrchestrator(const ShuffleOperatorConfig &config, const size_t exploration_interval = 8)
+        : config(config), exploration_interval(exploration_interval) {
+        assert(exploration_interval != 1);
+    }
+
+    // Shuffles one micro-batch of num_tuples generated tuples.
+    std::vector<size_t> run(const size_t num_tuples) {
+        return run(num_tuples, std::random_device{}());
+    }
+
+    // the micro-batch is GeneratedRelation(num_tuples, key distribution, seed), the skew is sampled from its first morsels
+    std::vector<size_t> run(const size_t num_tuples, const uint64_t seed) {
+        last_sample = take_sample(num_tuples, seed);
+        ShuffleOperatorConfig batch_config = config;
+        batch_config.algorithm = choose_algorithm(last_sample);
+        const BasicShuffleOperator<precompiled_partitions...> shuffle_operator(batch_config);
+        last_algorithm = shuffle_operator.get_algorithm();
+        ++batches;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto written_tuples = shuffle_operator.run(num_tuples, seed);
+        const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+        if (num_tuples > 0) {
+            model.observe(last_algorithm, last_sample, duration.count() * static_cast<double>(config.num_threads) / static_cast<double>(num_tuples));
+        }
+        return written_tuples;
+    }
+
+    // the next micro-batches draw their keys from key_distribution, e.g. a stream that becomes skewed
+    void set_key_distribution(const KeyDistribution &key_distribution) {
+        config.key_distribution = key_distribution;
+    }
+
+    // Runs every runnable algorithm once on num_tuples tuples, so the first micro-batches already use measured costs.
+    void calibrate(const size_t num_tuples) {
+        if (num_tuples == 0) {
+            return;
+        }
+        const uint64_t seed = std::random_device{}();
+        const auto sample = take_sample(num_tuples, seed);
+        for (const auto algorithm: rank_runnable(sample)) {
+            ShuffleOperatorConfig calibration_config = config;
+            calibration_config.algorithm = algorithm;
+            const BasicShuffleOperator<precompiled_partitions...> shuffle_operator(calibration_config);
+            const auto start = std::chrono::steady_clock::now();
+            shuffle_operator.run(num_tuples, seed);
+            const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+            model.observe(algorithm, sample, duration.count() * static_cast<double>(config.num_threads) / static_cast<double>(num_tuples));
+        }
+    }
+
+    [[nodiscard]] ShuffleAlgorithm get_last_algorithm() const {
+        return last_algorithm;
+    }
+
+    [[nodiscard]] const ShuffleSample &get_last_sample() const {
+        return last_sample;
+    }
+
+    [[nodiscard]] const ShuffleCostModel &get_cost_model() const {
+        return model;
+    }
+
+    // e.g. to feed in measurements of earlier runs
+    ShuffleCostModel &get_cost_model() {
+        return model;
+    }
+
+    [[nodiscard]] const ShuffleOperatorConfig &get_config() const {
+        return config;
+    }
+};
+
+using AdaptiveShuffleOrchestrator = BasicAdaptiveShuffleOrchestrator<16, 32, 64, 128, 256, 512, 1024, 2048, 4096>;
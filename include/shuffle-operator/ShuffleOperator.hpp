@@ -0,0 +1,158 @@
+#pragma once
+
+#include "cmp/orchestration/CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator.hpp"
+#include "hybrid/orchestration/HybridOrchestrator.hpp"
+#include "lpam/orchestrator/LocalPagesAndMergeOrchestrator.hpp"
+#include "radix/orchestration/RadixOrchestrator.hpp"
+#include "smb/orchestration/SmbBatchedOrchestrator.hpp"
+#include "smb/orchestration/SmbRuntimeOrchestrator.hpp"
+#include "tuple-generator/KeyDistribution.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "tuple-types/tuple-types.hpp"
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+enum class ShuffleAlgorithm {
+    Smb,
+    Radix,
+    Hybrid,
+    LocalPagesAndMerge,
+    CollaborativeMorselProcessing,
+};
+
+inline const char *get_shuffle_algorithm_name(const ShuffleAlgorithm algorithm) {
+    switch (algorithm) {
+        case ShuffleAlgorithm::Smb:
+            return "smb";
+        case ShuffleAlgorithm::Radix:
+            return "radix";
+        case ShuffleAlgorithm::Hybrid:
+            return "hybrid";
+        case ShuffleAlgorithm::LocalPagesAndMerge:
+            return "lpam";
+        case ShuffleAlgorithm::CollaborativeMorselProcessing:
+            return "cmp";
+    }
+    return "unknown";
+}
+
+enum class TupleLayout {
+    Tuple4,
+    Tuple16,
+    Tuple100,
+};
+
+template<typename T>
+constexpr TupleLayout get_tuple_layout() {
+    if constexpr (std::is_same_v<T, Tuple4>) {
+        return TupleLayout::Tuple4;
+    } else if constexpr (std::is_same_v<T, Tuple16>) {
+        return TupleLayout::Tuple16;
+    } else {
+        static_assert(std::is_same_v<T, Tuple100>, "Unsupported tuple type");
+        return TupleLayout::Tuple100;
+    }
+}
+
+struct ShuffleOperatorConfig {
+    ShuffleAlgorithm algorithm = ShuffleAlgorithm::Smb;
+    TupleLayout tuple_layout = TupleLayout::Tuple16;
+    size_t partitions = 32;
+    size_t page_size = 5 * 1024 * 1024;
+    size_t num_threads = 1;
+    bool force_runtime_path = false;
+    KeyDistribution key_distribution = KeyDistribution::uniform();
+};
+
+// Dispatches a runtime configuration to one of the pre-instantiated orchestrators.
+// Partition counts outside of precompiled_partitions (or a non-default page size) run on the
+// generic SMB path, which keeps partitions and page size as runtime values. That path runs SMB
+// whatever config.algorithm asks for, get_algorithm() returns the algorithm that actually runs.
+template<size_t... precompiled_partitions>
+class BasicShuffleOperator {
+    static constexpr size_t default_page_size = 5 * 1024 * 1024;
+    ShuffleOperatorConfig config;
+
+    template<typename Orchestrator>
+    static std::vector<size_t> run_orchestrator(Orchestrator &&orchestrator) {
+        orchestrator.run();
+        return orchestrator.get_written_tuples_per_partition();
+    }
+
+    // the batch size of a relation does not change its tuples, only the seed does
+    template<typename T, size_t batch_size = 2048>
+    GeneratedRelation<T, batch_size> make_input(const size_t num_tuples, const uint64_t seed) const {
+        return GeneratedRelation<T, batch_size>(num_tuples, config.key_distribution, seed);
+    }
+
+    template<typename T, size_t partitions>
+    std::vector<size_t> run_precompiled(const size_t num_tuples, const uint64_t seed) const {
+        switch (config.algorithm) {
+            case ShuffleAlgorithm::Smb:
+                return run_orchestrator(SmbBatchedOrchestrator<T, partitions, default_page_size>(make_input<T>(num_tuples, seed), config.num_threads));
+            case ShuffleAlgorithm::Radix:
+                return run_orchestrator(RadixOrchestrator<T, partitions, default_page_size>(make_input<T>(num_tuples, seed), config.num_threads));
+            case ShuffleAlgorithm::Hybrid:
+                return run_orchestrator(HybridOrchestrator<T, partitions, default_page_size>(make_input<T, 10 * 2048>(num_tuples, seed), config.num_threads));
+            case ShuffleAlgorithm::LocalPagesAndMerge:
+                return run_orchestrator(LocalPagesAndMergeOrchestrator<T, partitions, default_page_size>(make_input<T>(num_tuples, seed), config.num_threads));
+            case ShuffleAlgorithm::CollaborativeMorselProcessing:
+                return run_orchestrator(CollaborativeMorselProcessingThreadPoolWithProcessingUnitsOrchestrator<T, partitions, default_page_size>(make_input<T, 10 * 2048>(num_tuples, seed), config.num_threads));
+        }
+        return {};
+    }
+
+    template<typename T>
+    std::vector<size_t> run_runtime(const size_t num_tuples, const uint64_t seed) const {
+        return run_orchestrator(SmbRuntimeOrchestrator<T>(make_input<T>(num_tuples, seed), config.num_threads, config.partitions, config.page_size));
+    }
+
+    template<typename T>
+    std::vector<size_t> run_with_tuple_type(const size_t num_tuples, const uint64_t seed) const {
+        if (uses_precompiled_path()) {
+            std::vector<size_t> written_tuples;
+            ((config.partitions == precompiled_partitions && (written_tuples = run_precompiled<T, precompiled_partitions>(num_tuples, seed), true)) || ...);
+            return written_tuples;
+        }
+        return run_runtime<T>(num_tuples, seed);
+    }
+
+public:
+    explicit BasicShuffleOperator(const ShuffleOperatorConfig &config) : config(config) {
+    }
+
+    [[nodiscard]] bool uses_precompiled_path() const {
+        return !config.force_runtime_path && config.page_size == default_page_size && ((config.partitions == precompiled_partitions) || ...);
+    }
+
+    [[nodiscard]] ShuffleAlgorithm get_algorithm() const {
+        return uses_precompiled_path() ? config.algorithm : ShuffleAlgorithm::Smb;
+    }
+
+    [[nodiscard]] const ShuffleOperatorConfig &get_config() const {
+        return config;
+    }
+
+    std::vector<size_t> run(const size_t num_tuples) const {
+        return run(num_tuples, std::random_device{}());
+    }
+
+    // shuffles the tuples of GeneratedRelation(num_tuples, config.key_distribution, seed)
+    std::vector<size_t> run(const size_t num_tuples, const uint64_t seed) const {
+        switch (config.tuple_layout) {
+            case TupleLayout::Tuple4:
+                return run_with_tuple_type<Tuple4>(num_tuples, seed);
+            case TupleLayout::Tuple16:
+                return run_with_tuple_type<Tuple16>(num_tuples, seed);
+            case TupleLayout::Tuple100:
+                return run_with_tuple_type<Tuple100>(num_tuples, seed);
+        }
+        return {};
+    }
+};
+
+using ShuffleOperator = BasicShuffleOperator<16, 32, 64, 128, 256, 512, 1024>;
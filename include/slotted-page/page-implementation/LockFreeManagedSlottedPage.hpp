@@ -6,12 +6,14 @@
 #include <vector>
 
 #include "slotted-page/page-implementation/HeaderInfo.hpp"
+#include "slotted-page/page-implementation/PageStore.hpp"
 #include "slotted-page/page-implementation/SlotInfo.hpp"
+#include "slotted-page/page-pool/SlottedPagePool.hpp"
 
 template<typename T>
 class LockFreeManagedSlottedPage {
     size_t page_size;
-    std::unique_ptr<uint8_t[]> page_data;
+    PooledPageMemory page_data;
     HeaderInfoAtomic *header;
     SlotInfo<T> *slots;
     T *data_section;
@@ -29,9 +31,9 @@ public:
         unsigned tuples_to_write;
     };
 
-    explicit LockFreeManagedSlottedPage(const size_t page_size)
+    explicit LockFreeManagedSlottedPage(const size_t page_size, const int numa_node = -1)
         : page_size(page_size) {
-        page_data = std::make_unique<uint8_t[]>(page_size);
+        page_data = SlottedPagePool::acquire(page_size, numa_node);
 
         header = reinterpret_cast<HeaderInfoAtomic *>(page_data.get());
         slots = reinterpret_cast<SlotInfo<T> *>(page_data.get() + sizeof(HeaderInfoAtomic));
@@ -80,6 +82,10 @@ public:
     }
 
     static void add_batch_using_index(const T *buffer, const BatchedWriteInfo &wi) {
+        if (StreamingPageWriter::streams<T>(wi.tuples_to_write)) {
+            StreamingPageWriter::write_tuple_batch(wi.page_data, wi.page_size, sizeof(HeaderInfoAtomic), buffer, wi.tuple_index, wi.tuples_to_write);
+            return;
+        }
         const auto slot_start = reinterpret_cast<SlotInfo<T> *>(wi.page_data + sizeof(HeaderInfoAtomic) + wi.tuple_index * sizeof(SlotInfo<T>));
         unsigned tuple_offset = wi.page_size - (wi.tuple_index + 1) * T::get_size_of_variable_data();
         for (unsigned i = 0; i < wi.tuples_to_write; ++i) {
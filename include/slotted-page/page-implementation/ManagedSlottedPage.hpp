@@ -6,11 +6,13 @@
 #include <vector>
 
 #include "slotted-page/page-implementation/HeaderInfo.hpp"
+#include "slotted-page/page-implementation/PageStore.hpp"
 #include "slotted-page/page-implementation/SlotInfo.hpp"
+#include "slotted-page/page-pool/SlottedPagePool.hpp"
 
 template<typename T>
 class ManagedSlottedPage {
-    std::unique_ptr<uint8_t[]> page_data;
+    PooledPageMemory page_data;
     size_t page_size;
     size_t max_tuples;
     HeaderInfoNonAtomic *header;
@@ -18,8 +20,8 @@ class ManagedSlottedPage {
     T *data_section;
 
 public:
-    explicit ManagedSlottedPage(const size_t page_size)
-        : page_data(std::make_unique<uint8_t[]>(page_size)), page_size(page_size), max_tuples(get_max_tuples(page_size)) {
+    explicit ManagedSlottedPage(const size_t page_size, const int numa_node = -1)
+        : page_data(SlottedPagePool::acquire(page_size, numa_node)), page_size(page_size), max_tuples(get_max_tuples(page_size)) {
 
         header = reinterpret_cast<HeaderInfoNonAtomic *>(page_data.get());
         slots = reinterpret_cast<SlotInfo<T> *>(page_data.get() + sizeof(HeaderInfoAtomic));
@@ -54,6 +56,10 @@ public:
     }
 
     void add_tuple_batch_with_index(const T *buffer, const unsigned index, const unsigned tuples_to_write) {
+        if (StreamingPageWriter::streams<T>(tuples_to_write)) {
+            StreamingPageWriter::write_tuple_batch(page_data.get(), page_size, sizeof(HeaderInfoNonAtomic), buffer, index, tuples_to_write);
+            return;
+        }
         unsigned first_tuple_offset_from_end = 0;
         if constexpr (T::get_size_of_variable_data() > 0) {
             first_tuple_offset_from_end = page_size - (index + 1) * T::get_size_of_variable_data();
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include <new>
+
+#include "slotted-page/page-implementation/SlotInfo.hpp"
+
+// How the batched page writes store the slots and tuple data of a flushed buffer.
+enum class PageStore {
+    // plain stores, the written page lines are pulled into the cache
+    Regular,
+    // staged in a small cache-resident buffer and written as whole cache lines with non-temporal stores, so pages
+    // that are not read again soon do not evict the partition buffers of the worker (many partitions)
+    Streaming,
+};
+
+inline const char *get_page_store_name(const PageStore store) {
+    switch (store) {
+        case PageStore::Regular:
+            return "regular";
+        case PageStore::Streaming:
+            return "streaming";
+    }
+    return "unknown";
+}
+
+// Software write-combining buffer for one contiguous destination range: bytes are appended in order and every
+// completed destination cache line is written with a single non-temporal store. The partial lines at both ends of
+// the range may be shared with ranges of other threads and are written with regular stores.
+class WriteCombiningBuffer {
+    static constexpr size_t line_size = 64;
+    static constexpr size_t staged_lines = 64;
+
+    alignas(line_size) uint8_t staging[line_size * staged_lines];
+    // destination of staging[0]
+    uint8_t *destination_line;
+    // staging[begin, end) holds data, begin is only non-zero in the first line of the range
+    size_t begin;
+    size_t end;
+
+    static void stream_line(uint8_t *destination, const uint8_t *source) {
+#if defined(__AVX512F__)
+        _mm512_stream_si512(reinterpret_cast<__m512i *>(destination), _mm512_load_si512(source));
+#elif defined(__AVX__)
+        _mm256_stream_si256(reinterpret_cast<__m256i *>(destination), _mm256_load_si256(reinterpret_cast<const __m256i *>(source)));
+        _mm256_stream_si256(reinterpret_cast<__m256i *>(destination + 32), _mm256_load_si256(reinterpret_cast<const __m256i *>(source + 32)));
+#else
+        for (size_t i = 0; i < line_size; i += 16) {
+            _mm_stream_si128(reinterpret_cast<__m128i *>(destination + i), _mm_load_si128(reinterpret_cast<const __m128i *>(source + i)));
+        }
+#endif
+    }
+
+    // writes all complete lines and moves the trailing partial line to the front
+    void write_complete_lines() {
+        const auto complete_lines = end / line_size;
+        for (size_t line = 0; line < complete_lines; ++line) {
+            if (line == 0 && begin > 0) {
+                std::memcpy(destination_line + begin, staging + begin, line_size - begin);
+            } else {
+                stream_line(destination_line + line * line_size, staging + line * line_size);
+            }
+        }
+        if (complete_lines > 0) {
+            std::memcpy(staging, staging + complete_lines * line_size, end % line_size);
+            destination_line += complete_lines * line_size;
+            begin = 0;
+            end %= line_size;
+        }
+    }
+
+public:
+    explicit WriteCombiningBuffer(uint8_t *destination)
+        : destination_line(reinterpret_cast<uint8_t *>(reinterpret_cast<uintptr_t>(destination) & ~(line_size - 1))),
+          begin(static_cast<size_t>(destination - destination_line)), end(begin) {
+    }
+
+    WriteCombiningBuffer(const WriteCombiningBuffer &) = delete;
+    WriteCombiningBuffer &operator=(const WriteCombiningBuffer &) = delete;
+
+    // the size is known at compile time, so the copy into the staging buffer is inlined
+    template<typename V>
+    void append(const V &value) {
+        static_assert(sizeof(V) <= line_size * (staged_lines - 1));
+        if (end + sizeof(V) > sizeof(staging)) {
+            write_complete_lines();
+        }
+        std::memcpy(staging + end, &value, sizeof(V));
+        end += sizeof(V);
+    }
+
+    // writes the rest and orders the non-temporal stores before all later stores, e.g. the release of the page
+    void finish() {
+        write_complete_lines();
+        if (end > begin) {
+            std::memcpy(destination_line + begin, staging + begin, end - begin);
+        }
+        begin = end;
+        _mm_sfence();
+    }
+};
+
+// Page store used by the batched writes of all slotted pages, a process-wide setting like the PageAllocationPolicy.
+class StreamingPageWriter {
+    static inline std::atomic<PageStore> store = PageStore::Regular;
+
+public:
+    static PageStore get_store() {
+        return store.load(std::memory_order_relaxed);
+    }
+
+    static void set_store(const PageStore new_store) {
+        store.store(new_store, std::memory_order_relaxed);
+    }
+
+    // below a few cache lines the staging and the fence cost more than the cache pollution they avoid
+    static constexpr size_t min_streaming_bytes = 512;
+
+    // true if a batch of tuples_to_write tuples is written by write_tuple_batch
+    template<typename T>
+    static bool streams(const unsigned tuples_to_write) {
+        return get_store() == PageStore::Streaming && tuples_to_write * sizeof(SlotInfo<T>) >= min_streaming_bytes;
+    }
+
+    // Same layout as the regular batched writes: slot first_index + i holds the key of buffer[i], its tuple data is
+    // stored at page_size - (first_index + 1 + i) * size of variable data, i.e. the data section grows downwards.
+    template<typename T>
+    static void write_tuple_batch(uint8_t *page_data, const size_t page_size, const size_t header_size, const T *buffer, const unsigned first_index, const unsigned tuples_to_write) {
+        constexpr auto variable_size = T::get_size_of_variable_data();
+        WriteCombiningBuffer slots(page_data + header_size + first_index * sizeof(SlotInfo<T>));
+        for (unsigned i = 0; i < tuples_to_write; ++i) {
+            const SlotInfo<T> slot{static_cast<unsigned>(page_size - (first_index + 1 + i) * variable_size), variable_size, buffer[i].get_key()};
+            slots.append(slot);
+        }
+        slots.finish();
+
+        if constexpr (variable_size > 0) {
+            // ascending addresses, i.e. starting with the last tuple of the batch
+            WriteCombiningBuffer data(page_data + page_size - (first_index + tuples_to_write) * variable_size);
+            for (unsigned i = tuples_to_write; i-- > 0;) {
+                data.append(buffer[i].get_variable_data());
+            }
+            data.finish();
+        }
+    }
+};
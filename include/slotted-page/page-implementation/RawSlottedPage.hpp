@@ -7,7 +7,9 @@
 #include <vector>
 
 #include "slotted-page/page-implementation/HeaderInfo.hpp"
+#include "slotted-page/page-implementation/PageStore.hpp"
 #include "slotted-page/page-implementation/SlotInfo.hpp"
+#include "slotted-page/page-pool/SlottedPagePool.hpp"
 
 template<typename T>
 class RawSlottedPage {
@@ -19,9 +21,9 @@ class RawSlottedPage {
     size_t max_tuples;
 
 public:
-    explicit RawSlottedPage(size_t page_size)
+    explicit RawSlottedPage(size_t page_size, const int numa_node = -1)
         : page_size(page_size) {
-        page_data = std::make_shared<uint8_t[]>(page_size);
+        page_data = SlottedPagePool::acquire(page_size, numa_node);
 
         max_tuples = get_max_tuples(page_size);
         header = reinterpret_cast<HeaderInfoAtomic *>(page_data.get());
@@ -62,9 +64,14 @@ public:
     }
 
     static void write_tuple_batch(uint8_t *page_data, const size_t page_size, const T *buffer, const unsigned start_entry_num, const unsigned tuples_to_write) {
+        if (StreamingPageWriter::streams<T>(tuples_to_write)) {
+            StreamingPageWriter::write_tuple_batch(page_data, page_size, sizeof(HeaderInfoAtomic), buffer, start_entry_num, tuples_to_write);
+            return;
+        }
         unsigned first_tuple_offset_from_end = 0;
         if constexpr (T::get_size_of_variable_data() > 0) {
-            first_tuple_offset_from_end = page_size - (start_entry_num + tuples_to_write) * T::get_size_of_variable_data();
+            // the data of entry start_entry_num + i ends where the data of the entry before it starts
+            first_tuple_offset_from_end = page_size - (start_entry_num + 1) * T::get_size_of_variable_data();
             for (unsigned i = 0; i < tuples_to_write; ++i) {
                 auto tuple_start = page_data + first_tuple_offset_from_end - i * T::get_size_of_variable_data();
                 std::memcpy(tuple_start, &buffer[i].get_variable_data(), T::get_size_of_variable_data());
@@ -32,9 +32,8 @@ public:
         }
     }
 
-    std::array<std::vector<PageWriteInfo<T>>, partitions> get_write_info(const std::array<unsigned, partitions> &local_histogram) {
-        std::array<std::vector<PageWriteInfo<T>>, partitions> thread_write_info;
-
+    // appends the page ranges of the histogram to the write info of the thread, so its vectors are reused across chunks
+    void append_write_info(const std::array<unsigned, partitions> &local_histogram, std::array<std::vector<PageWriteInfo<T>>, partitions> &thread_write_info) {
         const auto random_partition_start = rand() % partitions;
         for (size_t i = 0; i < partitions; ++i) {
             const auto partition = (i + random_partition_start) % partitions;
@@ -62,8 +61,10 @@ public:
                 } while (tuples_to_write > 0);
             }
         }
+    }
 
-        return thread_write_info;
+    void release_partition(const size_t partition) {
+        partitions_data[partition] = {};
     }
 
     std::vector<size_t> get_written_tuples_per_partition() {
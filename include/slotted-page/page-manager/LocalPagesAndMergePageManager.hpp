@@ -60,6 +60,11 @@ public:
         }
     }
 
+    // only valid after all threads handed in their merged pages
+    void release_partition(const size_t partition) {
+        pages[partition].clear();
+    }
+
     std::vector<size_t> get_written_tuples_per_partition() {
         std::vector<size_t> written_tuples(partitions, 0);
         for (size_t partition = 0; partition < partitions; ++partition) {
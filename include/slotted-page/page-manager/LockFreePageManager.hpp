@@ -55,6 +55,12 @@ public:
         }
     }
 
+    // only valid once all writers are done
+    void release_partition(const size_t partition) {
+        current_pages[partition].store(nullptr);
+        pages[partition].clear();
+    }
+
     std::vector<size_t> get_written_tuples_per_partition() {
         std::vector<size_t> result(partitions, 0);
         for (size_t i = 0; i < partitions; ++i) {
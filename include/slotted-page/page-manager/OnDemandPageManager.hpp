@@ -1,51 +1,85 @@
 #pragma once
 
 #include "slotted-page/page-implementation/ManagedSlottedPage.hpp"
+#include "util/numa/NumaTopology.hpp"
 #include "util/padded/PaddedMutex.hpp"
 #include <array>
 #include <deque>
+#include <vector>
 
+// With NumaPlacement::PerNode every partition has one page chain (lane) per NUMA node and threads write into the
+// lane of the node they run on, otherwise there is a single lane per partition.
 template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
 class OnDemandPageManager {
-    std::array<PaddedMutex, partitions> partition_locks;
-    std::array<std::deque<ManagedSlottedPage<T>>, partitions> pages;
+    NumaPlacement placement;
+    size_t lanes_per_partition;
+    std::vector<PaddedMutex> partition_locks;
+    std::vector<std::deque<ManagedSlottedPage<T>>> pages;
+
+    [[nodiscard]] size_t get_lane(const size_t partition) const {
+        if (lanes_per_partition == 1) {
+            return partition;
+        }
+        return partition * lanes_per_partition + static_cast<size_t>(NumaTopology::get_current_node());
+    }
+
+    [[nodiscard]] int get_node_of_lane(const size_t lane) const {
+        switch (placement) {
+            case NumaPlacement::None:
+                return -1;
+            case NumaPlacement::HomeNode:
+                return static_cast<int>(lane % NumaTopology::get_num_nodes());
+            case NumaPlacement::PerNode:
+                return static_cast<int>(lane % lanes_per_partition);
+        }
+        return -1;
+    }
+
+    void add_page(const size_t lane) {
+        pages[lane].emplace_back(page_size, get_node_of_lane(lane));
+    }
 
 public:
-    OnDemandPageManager() {
-        for (size_t i = 0; i < partitions; ++i) {
-            pages[i].emplace_back(page_size);
+    explicit OnDemandPageManager(const NumaPlacement placement = NumaPlacement::None)
+        : placement(placement), lanes_per_partition(placement == NumaPlacement::PerNode ? NumaTopology::get_num_nodes() : 1),
+          partition_locks(partitions * lanes_per_partition), pages(partitions * lanes_per_partition) {
+        for (size_t lane = 0; lane < pages.size(); ++lane) {
+            add_page(lane);
         }
     }
 
     void insert_tuple(const T &tuple, size_t partition) {
-        std::lock_guard lock(partition_locks[partition]);
-        if (!pages[partition].back().add_tuple(tuple)) {
-            pages[partition].emplace_back(page_size);
-            pages[partition].back().add_tuple(tuple);
+        const auto lane = get_lane(partition);
+        std::lock_guard lock(partition_locks[lane]);
+        if (!pages[lane].back().add_tuple(tuple)) {
+            add_page(lane);
+            pages[lane].back().add_tuple(tuple);
         }
     }
 
     void insert_buffer_of_tuples(const T *buffer, const size_t num_tuples, const size_t partition) {
-        std::lock_guard lock(partition_locks[partition]);
+        const auto lane = get_lane(partition);
+        std::lock_guard lock(partition_locks[lane]);
         for (unsigned i = 0; i < num_tuples; i++) {
             const auto &tuple = buffer[i];
-            if (!pages[partition].back().add_tuple(tuple)) {
-                pages[partition].emplace_back(page_size);
-                pages[partition].back().add_tuple(tuple);
+            if (!pages[lane].back().add_tuple(tuple)) {
+                add_page(lane);
+                pages[lane].back().add_tuple(tuple);
             }
         }
     }
 
     void insert_buffer_of_tuples_batched(const T *buffer, const size_t num_tuples, const size_t partition) {
+        const auto lane = get_lane(partition);
         unsigned tuples_left = num_tuples, tuples_to_write = 0, index;
         ManagedSlottedPage<T> *current_page;
         {
-            std::lock_guard lock(partition_locks[partition]);
-            current_page = &pages[partition].back();
+            std::lock_guard lock(partition_locks[lane]);
+            current_page = &pages[lane].back();
             index = current_page->get_tuple_count();
             const auto tuples_left_on_page = ManagedSlottedPage<T>::get_max_tuples(page_size) - index;
             if (tuples_left_on_page == 0) {
-                pages[partition].emplace_back(page_size);
+                add_page(lane);
             } else {
                 tuples_left = num_tuples - std::min(tuples_left_on_page, num_tuples);
                 tuples_to_write = num_tuples - tuples_left;
@@ -60,11 +94,22 @@ public:
         }
     }
 
+    [[nodiscard]] NumaPlacement get_numa_placement() const {
+        return placement;
+    }
+
+    // hands the pages of a read partition back to the page pool, the partition must not be written afterwards
+    void release_partition(const size_t partition) {
+        for (size_t lane = partition * lanes_per_partition; lane < (partition + 1) * lanes_per_partition; ++lane) {
+            pages[lane].clear();
+        }
+    }
+
     std::vector<size_t> get_written_tuples_per_partition() {
         std::vector<size_t> result(partitions, 0);
-        for (size_t i = 0; i < partitions; ++i) {
-            for (const auto &page: pages[i]) {
-                result[i] += page.get_tuple_count();
+        for (size_t lane = 0; lane < pages.size(); ++lane) {
+            for (const auto &page: pages[lane]) {
+                result[lane / lanes_per_partition] += page.get_tuple_count();
             }
         }
         return result;
@@ -72,10 +117,10 @@ public:
 
     std::vector<std::vector<T>> get_all_tuples_per_partition() {
         std::vector<std::vector<T>> result(partitions);
-        for (size_t i = 0; i < partitions; ++i) {
-            for (const auto &page: pages[i]) {
+        for (size_t lane = 0; lane < pages.size(); ++lane) {
+            for (const auto &page: pages[lane]) {
                 auto tuples = page.get_all_tuples();
-                result[i].insert(result[i].end(), tuples.begin(), tuples.end());
+                result[lane / lanes_per_partition].insert(result[lane / lanes_per_partition].end(), tuples.begin(), tuples.end());
             }
         }
         return result;
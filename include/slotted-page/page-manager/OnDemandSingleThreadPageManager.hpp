@@ -44,6 +44,10 @@ public:
     }
 
 
+    void release_partition(const size_t partition) {
+        pages[partition].clear();
+    }
+
     std::vector<size_t> get_written_tuples_per_partition() {
         std::vector<size_t> result(partitions, 0);
         for (size_t i = 0; i < partitions; ++i) {
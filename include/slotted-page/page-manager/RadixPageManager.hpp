@@ -4,83 +4,218 @@
 #include "slotted-page/page-manager/PageWriteInfo.hpp"
 #include "slotted-page/page-manager/PartitionData.hpp"
 #include "slotted-page/page-pool/SlottedPagePool.hpp"
+#include "util/numa/NumaTopology.hpp"
 #include "util/padded/PaddedMutex.hpp"
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <barrier>
+#include <memory>
 #include <mutex>
 #include <vector>
 
+// How the histogram chunks of the threads are turned into page ranges.
+enum class HistogramMerge {
+    // every chunk takes the lock of each of its non-empty partitions and reserves its range on its own
+    Locking,
+    // all threads publish their histograms and meet at a barrier, each computes the prefix sums of a share of the
+    // partitions and afterwards every thread takes its page ranges without a lock, every thread has to add exactly
+    // one chunk per round
+    Barrier,
+};
+
+inline const char *get_histogram_merge_name(const HistogramMerge merge) {
+    switch (merge) {
+        case HistogramMerge::Locking:
+            return "locking";
+        case HistogramMerge::Barrier:
+            return "barrier";
+    }
+    return "unknown";
+}
+
+// Partitions are split into lanes like in OnDemandPageManager, with NumaPlacement::PerNode a histogram chunk is
+// assigned pages of the lanes of the node its thread runs on.
 template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
 class RadixPageManager {
     size_t num_threads;
     size_t tuples_per_page = RawSlottedPage<T>::get_max_tuples(page_size);
-    std::array<size_t, partitions> global_histogram;
-    std::array<PartitionData<T>, partitions> partitions_data;
-    std::array<PaddedMutex, partitions> partition_locks;
+    NumaPlacement placement;
+    size_t lanes_per_partition;
+    std::vector<size_t> global_histogram;
+    std::vector<PartitionData<T>> partitions_data;
+    std::vector<PaddedMutex> partition_locks;
+
+    // HistogramMerge::Barrier, indexed by the slot a thread draws for the current round
+    HistogramMerge merge;
+    std::atomic<size_t> next_slot = 0;
+    std::unique_ptr<std::barrier<>> merge_barrier;
+    std::vector<unsigned> slot_histograms;
+    // position of the first tuple of the slot in its lane of the partition
+    std::vector<size_t> slot_offsets;
+    std::vector<size_t> slot_node_lanes;
+
+    [[nodiscard]] int get_node_of_lane(const size_t lane) const {
+        switch (placement) {
+            case NumaPlacement::None:
+                return -1;
+            case NumaPlacement::HomeNode:
+                return static_cast<int>(lane % NumaTopology::get_num_nodes());
+            case NumaPlacement::PerNode:
+                return static_cast<int>(lane % lanes_per_partition);
+        }
+        return -1;
+    }
+
+    void allocate_new_page(size_t lane) {
+        // the current page may still have room for the next chunk, assign_pages moves on to the new page once it is full
+        partitions_data[lane].pages.emplace_back(page_size, get_node_of_lane(lane));
+    }
 
-    void allocate_new_page(size_t partition) {
-        partitions_data[partition].pages.emplace_back(page_size);
-        partitions_data[partition].current_tuple_offset = 0;
+    // lanes [first_lane, last_lane) are summed up by one thread, the chunks of the round are placed in slot order
+    void compute_prefix_sums(const size_t first_lane, const size_t last_lane) {
+        for (size_t lane = first_lane; lane < last_lane; ++lane) {
+            const size_t partition = lane / lanes_per_partition;
+            const size_t old_histogram_state = global_histogram[lane];
+            size_t position = old_histogram_state;
+            for (size_t slot = 0; slot < num_threads; ++slot) {
+                if (slot_node_lanes[slot] == lane % lanes_per_partition) {
+                    slot_offsets[slot * partitions + partition] = position;
+                    position += slot_histograms[slot * partitions + partition];
+                }
+            }
+            if (position == old_histogram_state) {
+                continue;
+            }
+            allocate_pages_for_new_histogram_state(lane, position - old_histogram_state, old_histogram_state);
+            global_histogram[lane] = position;
+            // same state as after assign_pages, i.e. a full page stays the current one
+            partitions_data[lane].current_page = (position - 1) / tuples_per_page;
+            partitions_data[lane].current_tuple_offset = position - partitions_data[lane].current_page * tuples_per_page;
+        }
+    }
+
+    std::array<std::vector<PageWriteInfo<T>>, partitions> add_histogram_chunk_at_barrier(const std::array<unsigned, partitions> &local_histogram) {
+        const size_t slot = next_slot.fetch_add(1) % num_threads;
+        const size_t node_lane = lanes_per_partition == 1 ? 0 : static_cast<size_t>(NumaTopology::get_current_node());
+        std::copy(local_histogram.begin(), local_histogram.end(), slot_histograms.begin() + slot * partitions);
+        slot_node_lanes[slot] = node_lane;
+        merge_barrier->arrive_and_wait();
+
+        const size_t lanes = partitions * lanes_per_partition;
+        compute_prefix_sums(slot * lanes / num_threads, (slot + 1) * lanes / num_threads);
+        merge_barrier->arrive_and_wait();
+
+        std::array<std::vector<PageWriteInfo<T>>, partitions> thread_write_info;
+        for (size_t partition = 0; partition < partitions; ++partition) {
+            size_t tuples_to_write = local_histogram[partition];
+            if (tuples_to_write == 0) {
+                continue;
+            }
+            const auto &pages = partitions_data[partition * lanes_per_partition + node_lane].pages;
+            size_t position = slot_offsets[slot * partitions + partition];
+            do {
+                const size_t offset_in_page = position % tuples_per_page;
+                const size_t tuples_for_page = std::min(tuples_per_page - offset_in_page, tuples_to_write);
+                thread_write_info[partition].emplace_back(pages[position / tuples_per_page], offset_in_page, tuples_for_page);
+                position += tuples_for_page;
+                tuples_to_write -= tuples_for_page;
+            } while (tuples_to_write > 0);
+        }
+        return thread_write_info;
     }
 
 public:
-    explicit RadixPageManager(const size_t num_threads) : num_threads(num_threads) {
-        global_histogram.fill(0);
+    explicit RadixPageManager(const size_t num_threads, const NumaPlacement placement = NumaPlacement::None, const HistogramMerge merge = HistogramMerge::Locking)
+        : num_threads(num_threads), placement(placement), lanes_per_partition(placement == NumaPlacement::PerNode ? NumaTopology::get_num_nodes() : 1),
+          global_histogram(partitions * lanes_per_partition, 0), partitions_data(partitions * lanes_per_partition), partition_locks(partitions * lanes_per_partition), merge(merge) {
+        if (merge == HistogramMerge::Barrier) {
+            merge_barrier = std::make_unique<std::barrier<>>(static_cast<std::ptrdiff_t>(num_threads));
+            slot_histograms.resize(num_threads * partitions);
+            slot_offsets.resize(num_threads * partitions);
+            slot_node_lanes.resize(num_threads);
+        }
     }
 
-    void allocate_pages_for_new_histogram_state(const size_t partition, const size_t tuples_to_write, const size_t old_histogram_state) {
+    void allocate_pages_for_new_histogram_state(const size_t lane, const size_t tuples_to_write, const size_t old_histogram_state) {
         const size_t total_pages_old = (old_histogram_state + tuples_per_page - 1) / tuples_per_page;
         const size_t total_pages_new = (old_histogram_state + tuples_to_write + tuples_per_page - 1) / tuples_per_page;
         auto page_diff = total_pages_new - total_pages_old;
         while (page_diff--) {
-            allocate_new_page(partition);
+            allocate_new_page(lane);
         }
     }
 
-    void assign_pages(const size_t partition, std::array<std::vector<PageWriteInfo<T>>, partitions> &thread_write_info, size_t tuples_to_write) {
+    void assign_pages(const size_t partition, const size_t lane, std::array<std::vector<PageWriteInfo<T>>, partitions> &thread_write_info, size_t tuples_to_write) {
         do {
-            const size_t current_tuple_offset = partitions_data[partition].current_tuple_offset;
-            auto &current_page = partitions_data[partition].pages[partitions_data[partition].current_page];
-            assert(partitions_data[partition].pages.size() > partitions_data[partition].current_page);
+            const size_t current_tuple_offset = partitions_data[lane].current_tuple_offset;
+            assert(partitions_data[lane].pages.size() > partitions_data[lane].current_page);
+            auto &current_page = partitions_data[lane].pages[partitions_data[lane].current_page];
             const size_t free_space = tuples_per_page - current_tuple_offset;
             const size_t tuples_for_page = std::min(free_space, tuples_to_write);
 
             thread_write_info[partition].emplace_back(current_page, current_tuple_offset, tuples_for_page);
             tuples_to_write -= tuples_for_page;
-            partitions_data[partition].current_tuple_offset += tuples_for_page;
+            partitions_data[lane].current_tuple_offset += tuples_for_page;
 
             if (tuples_to_write > 0) {
-                ++partitions_data[partition].current_page;
-                partitions_data[partition].current_tuple_offset = 0;
+                ++partitions_data[lane].current_page;
+                partitions_data[lane].current_tuple_offset = 0;
             }
         } while (tuples_to_write > 0);
     }
     std::array<std::vector<PageWriteInfo<T>>, partitions> add_histogram_chunk(const std::array<unsigned, partitions> &local_histogram) {
+        if (merge == HistogramMerge::Barrier) {
+            return add_histogram_chunk_at_barrier(local_histogram);
+        }
         const unsigned random_start_partition = rand() % partitions;
 
         std::array<std::vector<PageWriteInfo<T>>, partitions> thread_write_info;
+        const size_t node_lane = lanes_per_partition == 1 ? 0 : static_cast<size_t>(NumaTopology::get_current_node());
         for (size_t i = 0; i < partitions; ++i) {
             const auto partition = (random_start_partition + i) % partitions;
             size_t tuples_to_write = local_histogram[partition];
             if (tuples_to_write > 0) {
-                std::lock_guard lock(partition_locks[partition]);
-                const size_t old_histogram_state = global_histogram[partition];
-                global_histogram[partition] += tuples_to_write;
-                allocate_pages_for_new_histogram_state(partition, tuples_to_write, old_histogram_state);
-                assign_pages(partition, thread_write_info, tuples_to_write);
+                const auto lane = partition * lanes_per_partition + node_lane;
+                std::lock_guard lock(partition_locks[lane]);
+                const size_t old_histogram_state = global_histogram[lane];
+                global_histogram[lane] += tuples_to_write;
+                allocate_pages_for_new_histogram_state(lane, tuples_to_write, old_histogram_state);
+                assign_pages(partition, lane, thread_write_info, tuples_to_write);
             }
         }
 
         return thread_write_info;
     }
 
+    [[nodiscard]] NumaPlacement get_numa_placement() const {
+        return placement;
+    }
+
+    void release_partition(const size_t partition) {
+        for (size_t lane = partition * lanes_per_partition; lane < (partition + 1) * lanes_per_partition; ++lane) {
+            partitions_data[lane] = {};
+        }
+    }
+
     std::vector<size_t> get_written_tuples_per_partition() {
         std::vector<size_t> written_tuples(partitions, 0);
-        for (size_t partition = 0; partition < partitions; ++partition) {
-            for (const auto &page: partitions_data[partition].pages) {
-                written_tuples[partition] += page.get_tuple_count();
+        for (size_t lane = 0; lane < partitions_data.size(); ++lane) {
+            for (const auto &page: partitions_data[lane].pages) {
+                written_tuples[lane / lanes_per_partition] += page.get_tuple_count();
             }
         }
         return written_tuples;
     }
+
+    std::vector<std::vector<T>> get_all_tuples_per_partition() {
+        std::vector<std::vector<T>> result(partitions);
+        for (size_t lane = 0; lane < partitions_data.size(); ++lane) {
+            for (const auto &page: partitions_data[lane].pages) {
+                auto tuples = page.get_all_tuples();
+                result[lane / lanes_per_partition].insert(result[lane / lanes_per_partition].end(), tuples.begin(), tuples.end());
+            }
+        }
+        return result;
+    }
 };
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "slotted-page/page-implementation/ManagedSlottedPage.hpp"
+#include "util/padded/PaddedMutex.hpp"
+#include <deque>
+#include <mutex>
+#include <vector>
+
+template<typename T>
+class RuntimeOnDemandPageManager {
+    size_t partitions;
+    size_t page_size;
+    size_t max_tuples_per_page;
+    std::vector<PaddedMutex> partition_locks;
+    std::vector<std::deque<ManagedSlottedPage<T>>> pages;
+
+public:
+    RuntimeOnDemandPageManager(const size_t partitions, const size_t page_size)
+        : partitions(partitions), page_size(page_size), max_tuples_per_page(ManagedSlottedPage<T>::get_max_tuples(page_size)), partition_locks(partitions), pages(partitions) {
+        for (size_t i = 0; i < partitions; ++i) {
+            pages[i].emplace_back(page_size);
+        }
+    }
+
+    void insert_tuple(const T &tuple, size_t partition) {
+        std::lock_guard lock(partition_locks[partition]);
+        if (!pages[partition].back().add_tuple(tuple)) {
+            pages[partition].emplace_back(page_size);
+            pages[partition].back().add_tuple(tuple);
+        }
+    }
+
+    void insert_buffer_of_tuples_batched(const T *buffer, const size_t num_tuples, const size_t partition) {
+        unsigned tuples_left = num_tuples, tuples_to_write = 0, index;
+        ManagedSlottedPage<T> *current_page;
+        {
+            std::lock_guard lock(partition_locks[partition]);
+            current_page = &pages[partition].back();
+            index = current_page->get_tuple_count();
+            const auto tuples_left_on_page = max_tuples_per_page - index;
+            if (tuples_left_on_page == 0) {
+                pages[partition].emplace_back(page_size);
+            } else {
+                tuples_left = num_tuples - std::min(tuples_left_on_page, num_tuples);
+                tuples_to_write = num_tuples - tuples_left;
+                current_page->increase_tuple_count(tuples_to_write);
+            }
+        }
+        if (tuples_to_write > 0) {
+            current_page->add_tuple_batch_with_index(buffer, index, tuples_to_write);
+        }
+        if (tuples_left > 0) {
+            insert_buffer_of_tuples_batched(buffer + num_tuples - tuples_left, tuples_left, partition);
+        }
+    }
+
+    [[nodiscard]] size_t get_partition_count() const {
+        return partitions;
+    }
+
+    [[nodiscard]] size_t get_page_size() const {
+        return page_size;
+    }
+
+    void release_partition(const size_t partition) {
+        pages[partition].clear();
+    }
+
+    std::vector<size_t> get_written_tuples_per_partition() {
+        std::vector<size_t> result(partitions, 0);
+        for (size_t i = 0; i < partitions; ++i) {
+            for (const auto &page: pages[i]) {
+                result[i] += page.get_tuple_count();
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::vector<T>> get_all_tuples_per_partition() {
+        std::vector<std::vector<T>> result(partitions);
+        for (size_t i = 0; i < partitions; ++i) {
+            for (const auto &page: pages[i]) {
+                auto tuples = page.get_all_tuples();
+                result[i].insert(result[i].end(), tuples.begin(), tuples.end());
+            }
+        }
+        return result;
+    }
+};
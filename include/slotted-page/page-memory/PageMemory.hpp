@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <sys/mman.h>
+
+#include "util/numa/NumaTopology.hpp"
+
+enum class PageAllocation {
+    // value-initialized operator new[], i.e. a memset of the whole page
+    Zeroed,
+    // plain heap memory, the kernel faults in the pages on first write
+    Uninitialized,
+    // anonymous mapping aligned to 2 MiB with madvise(MADV_HUGEPAGE). Sparsely filled pages (many partitions, few
+    // tuples) are backed by whole huge pages, which can multiply the resident memory.
+    TransparentHugePages,
+    // MAP_HUGETLB, the size is rounded up to the huge page size. Falls back to transparent huge pages
+    // if no huge pages are reserved (vm.nr_hugepages).
+    HugeTlb2M,
+    HugeTlb1G,
+};
+
+struct PageAllocationPolicy {
+    PageAllocation allocation = PageAllocation::Uninitialized;
+    // touch every page right after the allocation instead of on the first write of a worker
+    bool prefault = false;
+
+    [[nodiscard]] std::string get_name() const {
+        std::string name;
+        switch (allocation) {
+            case PageAllocation::Zeroed:
+                name = "zeroed";
+                break;
+            case PageAllocation::Uninitialized:
+                name = "uninitialized";
+                break;
+            case PageAllocation::TransparentHugePages:
+                name = "thp";
+                break;
+            case PageAllocation::HugeTlb2M:
+                name = "hugetlb-2M";
+                break;
+            case PageAllocation::HugeTlb1G:
+                name = "hugetlb-1G";
+                break;
+        }
+        return prefault ? name + "-prefault" : name;
+    }
+};
+
+// Frees page memory with the call matching its allocation, mapped_bytes is 0 for heap memory.
+struct PageMemoryDeleter {
+    size_t mapped_bytes = 0;
+    bool allocated_with_new = false;
+
+    void operator()(uint8_t *ptr) const {
+        if (mapped_bytes > 0) {
+            munmap(ptr, mapped_bytes);
+        } else if (allocated_with_new) {
+            delete[] ptr;
+        } else {
+            std::free(ptr);
+        }
+    }
+};
+
+using PageMemory = std::unique_ptr<uint8_t[], PageMemoryDeleter>;
+
+// Allocates the memory of slotted pages. The policy is process-wide, set it before an orchestrator starts.
+class PageAllocator {
+    static constexpr size_t small_page_size = 4 * 1024;
+    static constexpr size_t huge_page_size_2m = 2 * 1024 * 1024;
+    static constexpr size_t huge_page_size_1g = 1024 * 1024 * 1024;
+
+    static inline PageAllocationPolicy policy;
+
+    static size_t round_up(const size_t bytes, const size_t alignment) {
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    static void touch_pages(uint8_t *memory, const size_t bytes) {
+        for (size_t offset = 0; offset < bytes; offset += small_page_size) {
+            memory[offset] = 0;
+        }
+    }
+
+    static void prefault_pages(uint8_t *memory, const size_t bytes) {
+        if (madvise(memory, bytes, MADV_POPULATE_WRITE) != 0) {
+            touch_pages(memory, bytes);
+        }
+    }
+
+    // node-local memory has to be mapped, mbind only affects pages that are not faulted in yet
+    static PageMemory map_on_node(const size_t bytes, const int node, const bool prefault) {
+        const size_t mapped_bytes = round_up(bytes, small_page_size);
+        void *memory = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (memory == MAP_FAILED) {
+            return nullptr;
+        }
+        NumaTopology::bind_memory(memory, mapped_bytes, node);
+        if (prefault) {
+            prefault_pages(static_cast<uint8_t *>(memory), mapped_bytes);
+        }
+        return PageMemory(static_cast<uint8_t *>(memory), PageMemoryDeleter{mapped_bytes});
+    }
+
+    static PageMemory map_transparent_huge_pages(const size_t bytes, const int node, const bool prefault) {
+        // over-allocate by one huge page and unmap the unaligned head and tail
+        const size_t mapped_bytes = round_up(bytes, small_page_size);
+        const size_t reserved_bytes = mapped_bytes + huge_page_size_2m;
+        void *reserved = mmap(nullptr, reserved_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (reserved == MAP_FAILED) {
+            return nullptr;
+        }
+        const auto reserved_begin = reinterpret_cast<uintptr_t>(reserved);
+        const auto aligned_begin = round_up(reserved_begin, huge_page_size_2m);
+        if (aligned_begin > reserved_begin) {
+            munmap(reserved, aligned_begin - reserved_begin);
+        }
+        const auto reserved_end = reserved_begin + reserved_bytes;
+        if (reserved_end > aligned_begin + mapped_bytes) {
+            munmap(reinterpret_cast<void *>(aligned_begin + mapped_bytes), reserved_end - aligned_begin - mapped_bytes);
+        }
+
+        auto *memory = reinterpret_cast<uint8_t *>(aligned_begin);
+        madvise(memory, mapped_bytes, MADV_HUGEPAGE);
+        NumaTopology::bind_memory(memory, mapped_bytes, node);
+        if (prefault) {
+            prefault_pages(memory, mapped_bytes);
+        }
+        return PageMemory(memory, PageMemoryDeleter{mapped_bytes});
+    }
+
+    static PageMemory map_huge_tlb(const size_t bytes, const size_t huge_page_size, const int huge_page_shift, const int node, const bool prefault) {
+        const size_t mapped_bytes = round_up(bytes, huge_page_size);
+        // MAP_POPULATE would fault in the pages before they are bound to the node
+        const bool populate = prefault && node < 0;
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (huge_page_shift << MAP_HUGE_SHIFT) | (populate ? MAP_POPULATE : 0);
+        void *memory = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (memory == MAP_FAILED) {
+            return map_transparent_huge_pages(bytes, node, prefault);
+        }
+        if (node >= 0) {
+            NumaTopology::bind_memory(memory, mapped_bytes, node);
+            if (prefault) {
+                prefault_pages(static_cast<uint8_t *>(memory), mapped_bytes);
+            }
+        }
+        return PageMemory(static_cast<uint8_t *>(memory), PageMemoryDeleter{mapped_bytes});
+    }
+
+public:
+    static const PageAllocationPolicy &get_policy() {
+        return policy;
+    }
+
+    static void set_policy(const PageAllocationPolicy &new_policy) {
+        policy = new_policy;
+    }
+
+    // the content is only zeroed with PageAllocation::Zeroed, node >= 0 binds the memory to that NUMA node
+    static PageMemory allocate(const size_t bytes, const PageAllocationPolicy &allocation_policy = get_policy(), const int node = -1) {
+        PageMemory memory;
+        const bool on_node = node >= 0 && NumaTopology::get_num_nodes() > 1;
+        switch (allocation_policy.allocation) {
+            case PageAllocation::Zeroed:
+                if (on_node) {
+                    // anonymous mappings are zero-filled
+                    memory = map_on_node(bytes, node, allocation_policy.prefault);
+                    break;
+                }
+                return PageMemory(new uint8_t[bytes](), PageMemoryDeleter{0, true});
+            case PageAllocation::Uninitialized:
+                if (on_node) {
+                    memory = map_on_node(bytes, node, allocation_policy.prefault);
+                    break;
+                }
+                memory = PageMemory(static_cast<uint8_t *>(std::malloc(bytes)));
+                if (memory && allocation_policy.prefault) {
+                    touch_pages(memory.get(), bytes);
+                }
+                break;
+            case PageAllocation::TransparentHugePages:
+                memory = map_transparent_huge_pages(bytes, on_node ? node : -1, allocation_policy.prefault);
+                break;
+            case PageAllocation::HugeTlb2M:
+                memory = map_huge_tlb(bytes, huge_page_size_2m, 21, on_node ? node : -1, allocation_policy.prefault);
+                break;
+            case PageAllocation::HugeTlb1G:
+                memory = map_huge_tlb(bytes, huge_page_size_1g, 30, on_node ? node : -1, allocation_policy.prefault);
+                break;
+        }
+        if (!memory) {
+            std::fputs("Failed to allocate page memory\n", stderr);
+            std::abort();
+        }
+        return memory;
+    }
+};
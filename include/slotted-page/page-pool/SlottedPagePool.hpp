@@ -1,35 +1,245 @@
 #pragma once
 
-constexpr auto PADDING = 0;
-
 #include <atomic>
-#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "slotted-page/page-memory/PageMemory.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
+
+// Hands the memory of a pooled page back to SlottedPagePool instead of freeing it.
+struct PooledPageDeleter {
+    size_t page_bytes = 0;
+    int node = -1;
+    PageAllocation allocation = PageAllocation::Uninitialized;
+    // pool generation the page was handed out in, pages of an older generation are freed on return
+    uint64_t generation = 0;
+    PageMemoryDeleter memory_deleter;
+
+    void operator()(uint8_t *ptr) const;
+};
+
+using PooledPageMemory = std::unique_ptr<uint8_t[], PooledPageDeleter>;
 
-template<size_t page_size = 5 * 1024 * 1024>
+// Process-wide free lists for the memory of slotted pages, shared by all page managers.
+// A page returns to the pool when it is destroyed, e.g. when a page manager releases a partition, and is handed
+// out again without a new allocation or page fault. Every thread caches a few pages per page size, NUMA node and
+// PageAllocation and exchanges them with the shared free lists in batches. Workers of the WorkerPool hand their cache
+// to the shared free lists whenever they become idle. The shared free lists keep at most get_max_shared_bytes(), pages
+// beyond that are freed, so the memory of one large shuffle does not stay resident. Recycled pages keep their old
+// content unless the allocation policy is PageAllocation::Zeroed. trim() starts a new generation: thread caches of an
+// older generation drop their pages the next time their thread uses the pool.
 class SlottedPagePool {
-    std::shared_ptr<uint8_t[]> page_data;
-    std::atomic<unsigned> current_page = 0;
-    unsigned max_pages = 0;
+    static constexpr size_t thread_cache_pages = 8;
+
+    struct FreeList {
+        size_t page_bytes;
+        // -1 for pages that are not bound to a node
+        int node;
+        PageAllocation allocation;
+        std::vector<PageMemory> pages;
+    };
+
+    struct ThreadCache {
+        std::vector<FreeList> free_lists;
+        uint64_t generation = current_generation.load();
+
+        ThreadCache() {
+            static std::once_flag registered;
+            std::call_once(registered, [] { WorkerPool::add_idle_callback(&release_thread_cache); });
+        }
+
+        ~ThreadCache() {
+            release_pages();
+            thread_cache_alive = false;
+        }
+
+        void release_pages() {
+            std::lock_guard lock(shared_mutex);
+            if (generation == current_generation.load()) {
+                for (auto &free_list: free_lists) {
+                    move_to_shared(free_list, free_list.pages.size());
+                }
+            }
+            free_lists.clear();
+        }
+    };
+
+    static inline std::atomic<uint64_t> current_generation = 0;
+    static inline std::atomic<size_t> max_shared_bytes = size_t{1} << 30;
+    static inline std::mutex shared_mutex;
+    static inline std::vector<FreeList> shared_free_lists;
+    // bytes of all pages in shared_free_lists, guarded by shared_mutex
+    static inline size_t shared_bytes = 0;
+    // trivially destructible, so pages destroyed after the thread cache of their thread go to the shared free lists
+    static inline thread_local bool thread_cache_alive = true;
+
+    static ThreadCache &get_thread_cache() {
+        thread_local ThreadCache thread_cache;
+        if (const auto generation = current_generation.load(); thread_cache.generation != generation) {
+            thread_cache.free_lists.clear();
+            thread_cache.generation = generation;
+        }
+        return thread_cache;
+    }
+
+    static FreeList &get_free_list(std::vector<FreeList> &free_lists, const size_t page_bytes, const int node, const PageAllocation allocation) {
+        for (auto &free_list: free_lists) {
+            if (free_list.page_bytes == page_bytes && free_list.node == node && free_list.allocation == allocation) {
+                return free_list;
+            }
+        }
+        return free_lists.emplace_back(page_bytes, node, allocation, std::vector<PageMemory>{});
+    }
+
+    // moves up to num_pages pages of a thread cache to the shared free lists and frees those above max_shared_bytes,
+    // must be called with shared_mutex held
+    static void move_to_shared(FreeList &from, const size_t num_pages) {
+        auto &to = get_free_list(shared_free_lists, from.page_bytes, from.node, from.allocation).pages;
+        for (size_t i = 0; i < num_pages && !from.pages.empty(); ++i) {
+            if (shared_bytes + from.page_bytes <= max_shared_bytes.load()) {
+                to.emplace_back(std::move(from.pages.back()));
+                shared_bytes += from.page_bytes;
+            }
+            from.pages.pop_back();
+        }
+    }
+
+    // must be called with shared_mutex held
+    static void move_from_shared(FreeList &to, const size_t num_pages) {
+        auto &from = get_free_list(shared_free_lists, to.page_bytes, to.node, to.allocation).pages;
+        for (size_t i = 0; i < num_pages && !from.empty(); ++i) {
+            to.pages.emplace_back(std::move(from.back()));
+            from.pop_back();
+            shared_bytes -= to.page_bytes;
+        }
+    }
+
+    static PooledPageMemory make_pooled(PageMemory memory, const size_t page_bytes, const int node, const PageAllocation allocation, const uint64_t generation) {
+        const auto memory_deleter = memory.get_deleter();
+        return PooledPageMemory(memory.release(), PooledPageDeleter{page_bytes, node, allocation, generation, memory_deleter});
+    }
+
+    // a recycled page has the content of its last use
+    static PooledPageMemory make_recycled(PageMemory memory, const size_t page_bytes, const int node, const PageAllocation allocation, const uint64_t generation) {
+        if (allocation == PageAllocation::Zeroed) {
+            std::memset(memory.get(), 0, page_bytes);
+        }
+        return make_pooled(std::move(memory), page_bytes, node, allocation, generation);
+    }
 
 public:
-    SlottedPagePool() = default;
-    explicit SlottedPagePool(const size_t pages) {
-        max_pages = pages;
-        page_data = std::make_shared<uint8_t[]>(pages * (page_size + PADDING));
+    // node >= 0 hands out pages bound to that NUMA node
+    static PooledPageMemory acquire(const size_t page_bytes, int node = -1) {
+        if (NumaTopology::get_num_nodes() == 1) {
+            node = -1;
+        }
+        const auto &policy = PageAllocator::get_policy();
+        const auto generation = current_generation.load();
+        if (thread_cache_alive) {
+            auto &cached = get_free_list(get_thread_cache().free_lists, page_bytes, node, policy.allocation);
+            if (cached.pages.empty()) {
+                std::lock_guard lock(shared_mutex);
+                move_from_shared(cached, thread_cache_pages / 2);
+            }
+            if (!cached.pages.empty()) {
+                auto memory = std::move(cached.pages.back());
+                cached.pages.pop_back();
+                return make_recycled(std::move(memory), page_bytes, node, policy.allocation, generation);
+            }
+        } else {
+            std::lock_guard lock(shared_mutex);
+            auto &shared_pages = get_free_list(shared_free_lists, page_bytes, node, policy.allocation).pages;
+            if (!shared_pages.empty()) {
+                auto memory = std::move(shared_pages.back());
+                shared_pages.pop_back();
+                shared_bytes -= page_bytes;
+                return make_recycled(std::move(memory), page_bytes, node, policy.allocation, generation);
+            }
+        }
+        return make_pooled(PageAllocator::allocate(page_bytes, policy, node), page_bytes, node, policy.allocation, generation);
     }
 
-    uint8_t *get_single_page() {
-        assert(current_page < max_pages);
-        return page_data.get() + current_page++ * (page_size + PADDING);
+    // pages handed out before the last trim() are freed
+    static void recycle(PageMemory memory, const size_t page_bytes, const int node, const PageAllocation allocation, const uint64_t generation) {
+        // the generation only changes under shared_mutex, so no page of an older generation enters the shared free lists
+        if (thread_cache_alive) {
+            auto &thread_cache = get_thread_cache();
+            if (generation != thread_cache.generation) {
+                return;
+            }
+            auto &cached = get_free_list(thread_cache.free_lists, page_bytes, node, allocation);
+            cached.pages.emplace_back(std::move(memory));
+            if (cached.pages.size() > thread_cache_pages) {
+                std::lock_guard lock(shared_mutex);
+                if (thread_cache.generation == current_generation.load()) {
+                    move_to_shared(cached, thread_cache_pages / 2);
+                }
+            }
+            return;
+        }
+        std::lock_guard lock(shared_mutex);
+        if (generation == current_generation.load() && shared_bytes + page_bytes <= max_shared_bytes.load()) {
+            get_free_list(shared_free_lists, page_bytes, node, allocation).pages.emplace_back(std::move(memory));
+            shared_bytes += page_bytes;
+        }
     }
 
-    uint8_t *get_multiple_pages(const size_t num_pages) {
-        assert(current_page + num_pages <= max_pages);
-        auto start = current_page.fetch_add(num_pages);
-        return page_data.get() + start * (page_size + PADDING);
+    // Hands the pages cached by the calling thread to the shared free lists, workers of the WorkerPool call it when
+    // they become idle.
+    static void release_thread_cache() {
+        if (thread_cache_alive) {
+            get_thread_cache().release_pages();
+        }
     }
-    auto has_free_page() const {
-        return current_page < max_pages;
+
+    // Limit of the shared free lists, pages returned beyond it are freed. Lowering it frees the excess pages right away.
+    static void set_max_shared_bytes(const size_t bytes) {
+        std::lock_guard lock(shared_mutex);
+        max_shared_bytes.store(bytes);
+        for (auto &[page_bytes, node, allocation, pages]: shared_free_lists) {
+            while (shared_bytes > bytes && !pages.empty()) {
+                pages.pop_back();
+                shared_bytes -= page_bytes;
+            }
+        }
+    }
+
+    [[nodiscard]] static size_t get_max_shared_bytes() {
+        return max_shared_bytes.load();
+    }
+
+    // Frees the pages cached by the calling thread and the shared free lists, e.g. before changing the page allocation
+    // policy. The caches of other threads are freed on their next acquire or recycle, pages in use when they return.
+    static void trim() {
+        {
+            std::lock_guard lock(shared_mutex);
+            current_generation.fetch_add(1);
+            shared_free_lists.clear();
+            shared_bytes = 0;
+        }
+        if (thread_cache_alive) {
+            get_thread_cache();
+        }
+    }
+
+    [[nodiscard]] static size_t get_cached_bytes() {
+        size_t cached_bytes = 0;
+        if (thread_cache_alive) {
+            for (const auto &[page_bytes, node, allocation, pages]: get_thread_cache().free_lists) {
+                cached_bytes += page_bytes * pages.size();
+            }
+        }
+        std::lock_guard lock(shared_mutex);
+        return cached_bytes + shared_bytes;
     }
 };
+
+inline void PooledPageDeleter::operator()(uint8_t *ptr) const {
+    SlottedPagePool::recycle(PageMemory(ptr, memory_deleter), page_bytes, node, allocation, generation);
+}
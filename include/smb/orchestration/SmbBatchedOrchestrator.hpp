@@ -1,39 +1,58 @@
 #pragma once
 
-#include <thread>
-
+#include "common/morsel-scheduling/ScheduledSource.hpp"
 #include "slotted-page/page-manager/OnDemandPageManager.hpp"
 #include "smb/worker/process_morsel_smb_batched.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class SmbBatchedOrchestrator {
     OnDemandPageManager<T, partitions, page_size> page_manager;
+    Input input;
     size_t num_tuples;
     size_t num_threads;
+    ThreadPlacement thread_placement;
+    MorselDispatch dispatch;
+
+    template<typename Sources>
+    void process_sources(Sources &sources, const std::vector<int> &cpus) {
+        WorkerPool::run(cpus, [&](const size_t i) {
+            process_morsel_smb_batched<T, partitions, page_size, PartitionHash>(sources[i], page_manager, num_threads);
+        });
+    }
 
 public:
-    explicit SmbBatchedOrchestrator(const size_t num_tuples, const size_t num_threads) : page_manager(), num_tuples(num_tuples), num_threads(num_threads) {
+    explicit SmbBatchedOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : SmbBatchedOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    SmbBatchedOrchestrator(Input input, const size_t num_threads, const NumaPlacement placement = NumaPlacement::None, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement(), const MorselDispatch dispatch = MorselDispatch::WorkStealing)
+        : page_manager(placement), input(std::move(input)), num_tuples(this->input.get_num_tuples()), num_threads(num_threads), thread_placement(thread_placement), dispatch(dispatch) {
     }
 
     void run() {
-        std::vector<std::jthread> threads;
-        threads.reserve(num_threads);
-        std::vector<BatchedTupleGenerator<T>> generators;
-        generators.reserve(num_threads);
-        for (unsigned i = 0; i < num_threads; i++) {
-            const auto tuple_to_process = num_tuples / num_threads + (i < num_tuples % num_threads);
-            generators.emplace_back(tuple_to_process);
-            threads.emplace_back([&, i] {
-                process_morsel_smb_batched<T, partitions, page_size>(generators[i], page_manager, num_threads);
-            });
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        if (dispatch == MorselDispatch::WorkStealing) {
+            MorselScheduler scheduler(num_tuples, num_threads, MorselScheduler::default_morsel_size, Input::Source::getBatchSize());
+            std::vector<ScheduledSource<T, Input>> sources;
+            sources.reserve(num_threads);
+            for (size_t i = 0; i < num_threads; i++) {
+                sources.emplace_back(input, scheduler, i);
+            }
+            process_sources(sources, cpus);
+            return;
         }
 
-        for (auto &thread: threads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
+        std::vector<typename Input::Source> sources;
+        sources.reserve(num_threads);
+        size_t first_tuple = 0;
+        for (unsigned i = 0; i < num_threads; i++) {
+            const auto tuple_to_process = num_tuples / num_threads + (i < num_tuples % num_threads);
+            sources.emplace_back(input.create_source(first_tuple, tuple_to_process));
+            first_tuple += tuple_to_process;
         }
+        process_sources(sources, cpus);
     }
 
     std::vector<size_t> get_written_tuples_per_partition() {
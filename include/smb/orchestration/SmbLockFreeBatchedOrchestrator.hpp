@@ -1,39 +1,39 @@
 #pragma once
 
-#include <thread>
-
 #include "slotted-page/page-manager/LockFreePageManager.hpp"
 #include "smb/worker/process_morsel_smb_lock_free_batched.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class SmbLockFreeBatchedOrchestrator {
     LockFreePageManager<T, partitions, page_size> page_manager;
+    Input input;
     size_t num_tuples;
     size_t num_threads;
+    ThreadPlacement thread_placement;
 
 public:
-    explicit SmbLockFreeBatchedOrchestrator(const size_t num_tuples, const size_t num_threads) : page_manager(), num_tuples(num_tuples), num_threads(num_threads) {
+    explicit SmbLockFreeBatchedOrchestrator(const size_t num_tuples, const size_t num_threads, const KeyDistribution &key_distribution = {}) : SmbLockFreeBatchedOrchestrator(Input(num_tuples, key_distribution), num_threads) {
+    }
+
+    SmbLockFreeBatchedOrchestrator(Input input, const size_t num_threads, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement()) : page_manager(), input(std::move(input)), num_tuples(this->input.get_num_tuples()), num_threads(num_threads), thread_placement(thread_placement) {
     }
 
     void run() {
-        std::vector<std::jthread> threads;
-        threads.reserve(num_threads);
-        std::vector<BatchedTupleGenerator<T>> generators;
-        generators.reserve(num_threads);
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        std::vector<typename Input::Source> sources;
+        sources.reserve(num_threads);
+        size_t first_tuple = 0;
         for (unsigned i = 0; i < num_threads; i++) {
             auto tuple_to_process = num_tuples / num_threads + (i < num_tuples % num_threads);
-            generators.emplace_back(tuple_to_process);
-            threads.emplace_back([&, i] {
-                process_morsel_smb_lock_free_batched<T, partitions, page_size>(generators[i], page_manager, num_threads);
-            });
-        }
-
-        for (auto &thread: threads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
+            sources.emplace_back(input.create_source(first_tuple, tuple_to_process));
+            first_tuple += tuple_to_process;
         }
+        WorkerPool::run(cpus, [&](const size_t i) {
+            process_morsel_smb_lock_free_batched<T, partitions, page_size, PartitionHash>(sources[i], page_manager, num_threads);
+        });
     }
     std::vector<size_t> get_written_tuples_per_partition() {
         return page_manager.get_written_tuples_per_partition();
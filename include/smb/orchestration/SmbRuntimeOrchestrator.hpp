@@ -0,0 +1,44 @@
+#pragma once
+
+#include "slotted-page/page-manager/RuntimeOnDemandPageManager.hpp"
+#include "smb/worker/process_morsel_smb_runtime.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
+#include "util/topology/ThreadPinning.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
+
+template<typename T, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
+class SmbRuntimeOrchestrator {
+    RuntimeOnDemandPageManager<T> page_manager;
+    Input input;
+    size_t num_tuples;
+    size_t num_threads;
+    ThreadPlacement thread_placement;
+
+public:
+    SmbRuntimeOrchestrator(const size_t num_tuples, const size_t num_threads, const size_t partitions, const size_t page_size = 5 * 1024 * 1024, const KeyDistribution &key_distribution = {})
+        : SmbRuntimeOrchestrator(Input(num_tuples, key_distribution), num_threads, partitions, page_size) {
+    }
+
+    SmbRuntimeOrchestrator(Input input, const size_t num_threads, const size_t partitions, const size_t page_size = 5 * 1024 * 1024, const ThreadPlacement thread_placement = ThreadPinning::get_default_placement())
+        : page_manager(partitions, page_size), input(std::move(input)), num_tuples(this->input.get_num_tuples()), num_threads(num_threads), thread_placement(thread_placement) {
+    }
+
+    void run() {
+        const auto cpus = ThreadPinning::get_cpus(thread_placement, num_threads);
+        std::vector<typename Input::Source> sources;
+        sources.reserve(num_threads);
+        size_t first_tuple = 0;
+        for (unsigned i = 0; i < num_threads; i++) {
+            const auto tuple_to_process = num_tuples / num_threads + (i < num_tuples % num_threads);
+            sources.emplace_back(input.create_source(first_tuple, tuple_to_process));
+            first_tuple += tuple_to_process;
+        }
+        WorkerPool::run(cpus, [&](const size_t i) {
+            process_morsel_smb_runtime<T, PartitionHash>(sources[i], page_manager, num_threads);
+        });
+    }
+
+    std::vector<size_t> get_written_tuples_per_partition() {
+        return page_manager.get_written_tuples_per_partition();
+    }
+};
@@ -1,16 +1,19 @@
 #pragma once
 
-#include "common/morsel-creation/MorselCreator.hpp"
 #include "slotted-page/page-manager/OnDemandSingleThreadPageManager.hpp"
 #include "smb/worker/process_morsel_smb.hpp"
+#include "tuple-source/GeneratedRelation.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSourceFactory<T> Input = GeneratedRelation<T>>
 class SmbSingleThreadOrchestrator {
-    BatchedTupleGenerator<T> generator;
+    typename Input::Source source;
     OnDemandSingleThreadPageManager<T, partitions, page_size> page_manager;
 
 public:
-    explicit SmbSingleThreadOrchestrator(size_t num_tuples) : generator(num_tuples) {
+    explicit SmbSingleThreadOrchestrator(const size_t num_tuples, const KeyDistribution &key_distribution = {}) : SmbSingleThreadOrchestrator(Input(num_tuples, key_distribution)) {
+    }
+
+    explicit SmbSingleThreadOrchestrator(const Input &input) : source(input.create_source(0, input.get_num_tuples())) {
     }
 
     void run() {
@@ -18,11 +21,13 @@ public:
         constexpr static auto buffer_size_per_partition = total_buffer_size / partitions;
         std::array<unsigned, partitions> buffer_index = {};
         std::unique_ptr<T[]> buffer = std::make_unique<T[]>(total_buffer_size);
+        std::unique_ptr<uint16_t[]> partition_ids = std::make_unique<uint16_t[]>(Input::Source::getBatchSize());
 
-        for (auto [batch, batch_size] = generator.getBatchOfTuples(); batch; std::tie(batch, batch_size) = generator.getBatchOfTuples()) {
-            for (size_t i = 0; i < batch_size; ++i) {
+        for (auto batch = source.next_batch(); !batch.empty(); batch = source.next_batch()) {
+            partition_function_batch<T, partitions, PartitionHash>(batch.data(), batch.size(), partition_ids.get());
+            for (size_t i = 0; i < batch.size(); ++i) {
                 const auto &tuple = batch[i];
-                const auto partition = partition_function<T, partitions>(tuple);
+                const auto partition = partition_ids[i];
                 auto &index = buffer_index[partition];
                 const auto partition_offset = partition * buffer_size_per_partition;
 
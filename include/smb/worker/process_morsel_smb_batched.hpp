@@ -1,25 +1,29 @@
 #pragma once
 
 #include "slotted-page/page-manager/OnDemandPageManager.hpp"
-#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-source/TupleSource.hpp"
+#include "util/partitioning_function.hpp"
+#include "util/worker-pool/get_worker_buffer.hpp"
 
-template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024>
-void process_morsel_smb_batched(BatchedTupleGenerator<T> &tuple_generator, OnDemandPageManager<T, partitions, page_size> &page_manager, const size_t num_threads) {
+template<typename T, size_t partitions, size_t page_size = 5 * 1024 * 1024, typename PartitionHash = IdentityHash, TupleSource<T> Source>
+void process_morsel_smb_batched(Source &tuple_source, OnDemandPageManager<T, partitions, page_size> &page_manager, const size_t num_threads) {
     static constexpr unsigned buffer_base_value = 2 * 1024;
     const static auto total_buffer_size = buffer_base_value * 1024 / (sizeof(T) * num_threads);
     const static auto buffer_size_per_partition = total_buffer_size / partitions;
     std::array<unsigned, partitions> buffer_index = {};
-    std::unique_ptr<T[]> buffer = std::make_unique<T[]>(total_buffer_size);
+    T *buffer = get_worker_buffer<T>(total_buffer_size);
+    uint16_t *partition_ids = get_worker_buffer<uint16_t>(Source::getBatchSize());
 
-    for (auto [batch, batch_size] = tuple_generator.getBatchOfTuples(); batch; std::tie(batch, batch_size) = tuple_generator.getBatchOfTuples()) {
-        for (size_t i = 0; i < batch_size; ++i) {
+    for (auto batch = tuple_source.next_batch(); !batch.empty(); batch = tuple_source.next_batch()) {
+        partition_function_batch<T, partitions, PartitionHash>(batch.data(), batch.size(), partition_ids);
+        for (size_t i = 0; i < batch.size(); ++i) {
             const auto &tuple = batch[i];
-            const auto partition = partition_function<T, partitions>(tuple);
+            const auto partition = partition_ids[i];
             auto &index = buffer_index[partition];
             const auto partition_offset = partition * buffer_size_per_partition;
 
             if (index == buffer_size_per_partition) {
-                page_manager.insert_buffer_of_tuples_batched(buffer.get() + partition_offset, buffer_size_per_partition, partition);
+                page_manager.insert_buffer_of_tuples_batched(buffer + partition_offset, buffer_size_per_partition, partition);
                 index = 0;
             }
 
@@ -31,7 +35,7 @@ void process_morsel_smb_batched(BatchedTupleGenerator<T> &tuple_generator, OnDem
     for (unsigned i = 0; i < partitions; ++i) {
         if (buffer_index[i] > 0) {
             const auto partition_offset = i * buffer_size_per_partition;
-            page_manager.insert_buffer_of_tuples_batched(buffer.get() + partition_offset, buffer_index[i], i);
+            page_manager.insert_buffer_of_tuples_batched(buffer + partition_offset, buffer_index[i], i);
         }
     }
 }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "slotted-page/page-manager/RuntimeOnDemandPageManager.hpp"
+#include "tuple-source/TupleSource.hpp"
+#include "util/partitioning_function.hpp"
+#include "util/worker-pool/get_worker_buffer.hpp"
+
+#include <vector>
+
+template<typename T, typename PartitionHash = IdentityHash, TupleSource<T> Source>
+void process_morsel_smb_runtime(Source &tuple_source, RuntimeOnDemandPageManager<T> &page_manager, const size_t num_threads) {
+    static constexpr unsigned buffer_base_value = 2 * 1024;
+    const auto partitions = page_manager.get_partition_count();
+    const RuntimePartitionFunction<PartitionHash> partition_function(partitions);
+    const auto total_buffer_size = buffer_base_value * 1024 / (sizeof(T) * num_threads);
+    const auto buffer_size_per_partition = std::max(total_buffer_size / partitions, 1ul);
+    // not unsigned, which could alias the keys of the tuples and be reloaded after every buffered tuple
+    std::vector<size_t> buffer_index(partitions, 0);
+    T *buffer = get_worker_buffer<T>(buffer_size_per_partition * partitions);
+    uint16_t *partition_ids = get_worker_buffer<uint16_t>(Source::getBatchSize());
+
+    for (auto batch = tuple_source.next_batch(); !batch.empty(); batch = tuple_source.next_batch()) {
+        partition_function(batch.data(), batch.size(), partition_ids);
+        const T *tuples = batch.data();
+        const size_t batch_size = batch.size();
+        size_t *indices = buffer_index.data();
+        for (size_t i = 0; i < batch_size; ++i) {
+            const auto partition = partition_ids[i];
+            auto index = indices[partition];
+            const auto partition_offset = partition * buffer_size_per_partition;
+
+            if (index == buffer_size_per_partition) [[unlikely]] {
+                page_manager.insert_buffer_of_tuples_batched(buffer + partition_offset, buffer_size_per_partition, partition);
+                index = 0;
+            }
+
+            buffer[partition_offset + index] = tuples[i];
+            indices[partition] = index + 1;
+        }
+    }
+
+    for (size_t i = 0; i < partitions; ++i) {
+        if (buffer_index[i] > 0) {
+            const auto partition_offset = i * buffer_size_per_partition;
+            page_manager.insert_buffer_of_tuples_batched(buffer + partition_offset, buffer_index[i], i);
+        }
+    }
+}
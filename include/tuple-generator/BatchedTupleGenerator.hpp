@@ -1,46 +1,118 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <immintrin.h>
 #include <iostream>
 #include <memory>
 #include <random>
+#include <span>
+
+#include "tuple-generator/KeyDistribution.hpp"
+#include "tuple-generator/Philox4x32.hpp"
 
 template<typename T, size_t batch_size = 2048>
 class BatchedTupleGenerator {
-    alignas(32) T batch[batch_size];
+    // the tuple data and the randomness of skewed key distributions come from separate Philox streams
+    static constexpr uint64_t tuple_stream = 0;
+    static constexpr uint64_t key_stream = 1;
+    static constexpr size_t blocks_per_batch = sizeof(T) * batch_size / Philox4x32::block_size;
+
+    alignas(64) T batch[batch_size];
     size_t max_generated_tuples;
     size_t generated_tuples = 0;
-    size_t current_batch_index = 0;
+    size_t current_batch_index = batch_size;
+    uint64_t next_batch_index = 0;
 
-    std::mt19937_64 gen;
+    Philox4x32 rng;
+    KeyDistribution key_distribution;
 
 public:
-    explicit BatchedTupleGenerator(const size_t max_generated_tuples, const uint64_t seed = std::random_device{}()) : max_generated_tuples(max_generated_tuples), gen(seed) {
-        generateBatchOfTuples();
+    explicit BatchedTupleGenerator(const size_t max_generated_tuples, const uint64_t seed = std::random_device{}()) : max_generated_tuples(max_generated_tuples), rng(seed) {
     }
 
-    void generateBatchOfTuples() {
-        constexpr size_t num_of_8_bytes = sizeof(T) * batch_size / sizeof(uint64_t);
-        auto *p = reinterpret_cast<uint64_t *>(&batch);
-        assert(reinterpret_cast<std::uintptr_t>(p) % 32 == 0 && "Pointer not 32-byte aligned!");
-        size_t i = 0;
+    BatchedTupleGenerator(const size_t max_generated_tuples, const KeyDistribution &key_distribution, const uint64_t seed = std::random_device{}())
+        : max_generated_tuples(max_generated_tuples), rng(seed), key_distribution(key_distribution) {
+    }
 
-        static_assert(num_of_8_bytes * sizeof(uint64_t) == sizeof(batch), "Size of T is not a multiple of 8 bytes!");
+    // the next batch is the batch_index-th batch of the random stream, so any thread can reproduce it from the seed
+    void seek_batch(const uint64_t batch_index) {
+        next_batch_index = batch_index;
+        current_batch_index = batch_size;
+    }
 
-#ifdef __AVX2__
-        for (; i + 3 < num_of_8_bytes; i += 4) {
-            __m256i random_numbers = _mm256_set_epi64x(gen(), gen(), gen(), gen());
-            _mm256_store_si256(reinterpret_cast<__m256i *>(&p[i]), random_numbers);
+    // the next tuple is the tuple_index-th tuple of the random stream, the rest of its batch is kept in the buffer
+    void seek_tuple(const uint64_t tuple_index) {
+        seek_batch(tuple_index / batch_size);
+        if (tuple_index % batch_size != 0) {
+            generateBatchOfTuples();
+            current_batch_index = tuple_index % batch_size;
         }
-#endif
-        for (; i < num_of_8_bytes; ++i) {
-            p[i] = gen();
+    }
+
+    // writes the batch_index-th batch of batch_size tuples to out
+    void generate_batch(T *out, const uint64_t batch_index) const {
+        static_assert(blocks_per_batch * Philox4x32::block_size == sizeof(batch), "Size of a batch is not a multiple of 16 bytes!");
+        static_assert(batch_size % 2 == 0, "Batch size must be even");
+        rng.fill(out, batch_index * blocks_per_batch, blocks_per_batch, tuple_stream);
+
+        if (!key_distribution.is_uniform()) {
+            constexpr size_t randoms_per_step = 64;
+            alignas(64) uint64_t randoms[randoms_per_step];
+            const uint64_t first_tuple = batch_index * batch_size;
+            for (size_t j = 0; j < batch_size; j += randoms_per_step) {
+                const size_t count = std::min(randoms_per_step, batch_size - j);
+                rng.fill(randoms, (first_tuple + j) / 2, (count + 1) / 2, key_stream);
+                for (size_t k = 0; k < count; ++k) {
+                    out[j + k].set_key(key_distribution.get_key(randoms[k], first_tuple + j + k));
+                }
+            }
         }
+    }
 
+    void generateBatchOfTuples() {
+        generate_batch(batch, next_batch_index++);
         current_batch_index = 0;
     }
 
+    // hands out the internal buffer, which stays valid until the generator is used again; empty once all tuples are generated
+    auto next_batch(const size_t max_tuples_generate = batch_size) -> std::span<const T> {
+        if (generated_tuples >= max_generated_tuples) {
+            return {};
+        }
+        if (current_batch_index >= batch_size) {
+            generateBatchOfTuples();
+        }
+
+        const auto length_of_batch = std::min({batch_size - current_batch_index, max_generated_tuples - generated_tuples, max_tuples_generate});
+        const T *first = batch + current_batch_index;
+        current_batch_index += length_of_batch;
+        generated_tuples += length_of_batch;
+        return {first, length_of_batch};
+    }
+
+    // writes up to out.size() tuples into caller-owned memory and returns their number, full batches bypass the internal buffer
+    size_t fill(const std::span<T> out) {
+        if (generated_tuples >= max_generated_tuples) {
+            return 0;
+        }
+        const auto length = std::min(out.size(), max_generated_tuples - generated_tuples);
+
+        // the rest of a partially handed out batch comes first
+        size_t written = std::min(length, batch_size - std::min(current_batch_index, batch_size));
+        std::copy(batch + current_batch_index, batch + current_batch_index + written, out.data());
+        current_batch_index += written;
+        for (; written + batch_size <= length; written += batch_size) {
+            generate_batch(out.data() + written, next_batch_index++);
+        }
+        if (written < length) {
+            generateBatchOfTuples();
+            current_batch_index = length - written;
+            std::copy(batch, batch + current_batch_index, out.data() + written);
+        }
+        generated_tuples += length;
+        return length;
+    }
 
     auto getTuple() -> std::unique_ptr<T> {
         if (generated_tuples >= max_generated_tuples) {
@@ -53,32 +125,14 @@ public:
         generated_tuples++;
         return std::make_unique<T>(batch[current_batch_index++]);
     }
-    auto getBatchOfTuples() -> std::pair<std::unique_ptr<T[]>, size_t> {
-        if (generated_tuples >= max_generated_tuples) {
-            return {std::unique_ptr<T[]>(nullptr), 0};
-        }
-        generateBatchOfTuples();
-
-        const auto length_of_batch = std::min(batch_size, max_generated_tuples - generated_tuples);
-
-        std::unique_ptr<T[]> batch_ptr = std::make_unique<T[]>(length_of_batch);
-        std::copy(batch, batch + length_of_batch, batch_ptr.get());
-        generated_tuples += length_of_batch;
-
-        return std::make_pair(std::move(batch_ptr), length_of_batch);
-    }
-
-    auto getBatchOfTuples(const size_t max_tuples_generate) -> std::pair<std::unique_ptr<T[]>, size_t> {
+    auto getBatchOfTuples(const size_t max_tuples_generate = batch_size) -> std::pair<std::unique_ptr<T[]>, size_t> {
         if (generated_tuples >= max_generated_tuples) {
             return {std::unique_ptr<T[]>(nullptr), 0};
         }
-        generateBatchOfTuples();
+        const auto length_of_batch = std::min({batch_size, max_generated_tuples - generated_tuples, max_tuples_generate});
 
-        const auto length_of_batch = std::min(std::min(batch_size, max_generated_tuples - generated_tuples), max_tuples_generate);
-
-        std::unique_ptr<T[]> batch_ptr = std::make_unique<T[]>(length_of_batch);
-        std::copy(batch, batch + length_of_batch, batch_ptr.get());
-        generated_tuples += length_of_batch;
+        std::unique_ptr<T[]> batch_ptr = std::make_unique_for_overwrite<T[]>(length_of_batch);
+        fill({batch_ptr.get(), length_of_batch});
 
         return std::make_pair(std::move(batch_ptr), length_of_batch);
     }
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+enum class KeyDistributionType {
+    Uniform,
+    Zipf,
+    HotKey,
+    Sequential,
+    HeavyHitters,
+};
+
+// Maps the uniform random bits of the tuple generator to keys of a (possibly skewed) distribution.
+// Instances are cheap to copy, the Zipf constants are precomputed once by the factory.
+class KeyDistribution {
+    KeyDistributionType type = KeyDistributionType::Uniform;
+    double parameter = 0;
+
+    // Zipf (Gray et al., "Quickly Generating Billion-Record Synthetic Databases"), rank 0 is the most frequent key
+    uint64_t num_keys = 0;
+    double zeta_n = 0;
+    double alpha = 0;
+    double eta = 0;
+    double second_rank_threshold = 0;
+
+    // hot key / heavy hitters: share of the tuples scaled to 2^32
+    uint64_t skewed_threshold = 0;
+    uint32_t num_heavy_hitters = 0;
+
+    static double zeta(const uint64_t n, const double theta) {
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        }
+        return sum;
+    }
+
+    static uint64_t scale_fraction(const double fraction) {
+        assert(fraction >= 0 && fraction <= 1);
+        return static_cast<uint64_t>(fraction * 4294967296.0);
+    }
+
+public:
+    KeyDistribution() = default;
+
+    static KeyDistribution uniform() {
+        return {};
+    }
+
+    // The method of Gray et al. only covers 0 < theta < 1, alpha = 1 / (1 - theta) is infinite or negative beyond. The
+    // check is not an assert, release builds would turn the rank into an undefined float to integer conversion.
+    static KeyDistribution zipf(const double theta, const uint64_t num_keys = 1u << 20) {
+        if (!(theta > 0 && theta < 1) || num_keys < 2) {
+            std::fprintf(stderr, "Zipf needs 0 < theta < 1 and at least 2 keys, got theta %g and %llu keys\n", theta, static_cast<unsigned long long>(num_keys));
+            std::abort();
+        }
+        KeyDistribution distribution;
+        distribution.type = KeyDistributionType::Zipf;
+        distribution.parameter = theta;
+        distribution.num_keys = num_keys;
+        distribution.zeta_n = zeta(num_keys, theta);
+        distribution.alpha = 1.0 / (1.0 - theta);
+        distribution.eta = (1.0 - std::pow(2.0 / static_cast<double>(num_keys), 1.0 - theta)) / (1.0 - zeta(2, theta) / distribution.zeta_n);
+        distribution.second_rank_threshold = 1.0 + std::pow(0.5, theta);
+        return distribution;
+    }
+
+    // hot_fraction of all tuples share key 0, the rest is uniform
+    static KeyDistribution hot_key(const double hot_fraction) {
+        KeyDistribution distribution;
+        distribution.type = KeyDistributionType::HotKey;
+        distribution.parameter = hot_fraction;
+        distribution.skewed_threshold = scale_fraction(hot_fraction);
+        return distribution;
+    }
+
+    // keys are the position of the tuple in the generated stream
+    static KeyDistribution sequential() {
+        KeyDistribution distribution;
+        distribution.type = KeyDistributionType::Sequential;
+        return distribution;
+    }
+
+    // heavy_hitter_fraction of all tuples is spread evenly over the keys 0..num_heavy_hitters-1, the rest is uniform
+    static KeyDistribution heavy_hitters(const uint32_t num_heavy_hitters, const double heavy_hitter_fraction) {
+        assert(num_heavy_hitters > 0);
+        KeyDistribution distribution;
+        distribution.type = KeyDistributionType::HeavyHitters;
+        distribution.parameter = heavy_hitter_fraction;
+        distribution.skewed_threshold = scale_fraction(heavy_hitter_fraction);
+        distribution.num_heavy_hitters = num_heavy_hitters;
+        return distribution;
+    }
+
+    [[nodiscard]] KeyDistributionType get_type() const {
+        return type;
+    }
+
+    [[nodiscard]] bool is_uniform() const {
+        return type == KeyDistributionType::Uniform;
+    }
+
+    [[nodiscard]] std::string get_name() const {
+        char name[48];
+        switch (type) {
+            case KeyDistributionType::Uniform:
+                return "uniform";
+            case KeyDistributionType::Zipf:
+                std::snprintf(name, sizeof(name), "zipf-%.2f", parameter);
+                return name;
+            case KeyDistributionType::HotKey:
+                std::snprintf(name, sizeof(name), "hot-key-%.2f", parameter);
+                return name;
+            case KeyDistributionType::Sequential:
+                return "sequential";
+            case KeyDistributionType::HeavyHitters:
+                std::snprintf(name, sizeof(name), "heavy-hitters-%u-%.2f", num_heavy_hitters, parameter);
+                return name;
+        }
+        return "unknown";
+    }
+
+    // random provides 64 uniform bits, sequence_number is the position of the tuple in the generated stream
+    [[nodiscard]] uint32_t get_key(const uint64_t random, const uint64_t sequence_number) const {
+        const auto low_bits = static_cast<uint32_t>(random);
+        switch (type) {
+            case KeyDistributionType::Uniform:
+                return low_bits;
+            case KeyDistributionType::Zipf: {
+                const double u = static_cast<double>(random >> 11) * 0x1.0p-53;
+                const double uz = u * zeta_n;
+                if (uz < 1.0) {
+                    return 0;
+                }
+                if (uz < second_rank_threshold) {
+                    return 1;
+                }
+                const auto rank = static_cast<uint64_t>(static_cast<double>(num_keys) * std::pow(eta * u - eta + 1.0, alpha));
+                return static_cast<uint32_t>(std::min(rank, num_keys - 1));
+            }
+            case KeyDistributionType::HotKey:
+                return (random >> 32) < skewed_threshold ? 0 : low_bits;
+            case KeyDistributionType::Sequential:
+                return static_cast<uint32_t>(sequence_number);
+            case KeyDistributionType::HeavyHitters:
+                if ((random >> 32) < skewed_threshold) {
+                    return static_cast<uint32_t>((static_cast<uint64_t>(low_bits) * num_heavy_hitters) >> 32);
+                }
+                return low_bits;
+        }
+        return low_bits;
+    }
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+// Counter-based Philox4x32-10 generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+// Block n of a stream is a pure function of (seed, stream, n), so every thread can reproduce any offset without
+// generating the preceding values. The SIMD paths compute 8 (AVX2) or 16 (AVX-512) blocks per step.
+class Philox4x32 {
+    static constexpr uint32_t multiplier_0 = 0xD2511F53;
+    static constexpr uint32_t multiplier_1 = 0xCD9E8D57;
+    static constexpr uint32_t weyl_0 = 0x9E3779B9;
+    static constexpr uint32_t weyl_1 = 0xBB67AE85;
+    static constexpr int rounds = 10;
+
+    uint32_t key_0;
+    uint32_t key_1;
+
+#ifdef __AVX2__
+    static void multiply_high_low(const __m256i a, const __m256i multiplier, __m256i &high, __m256i &low) {
+        const __m256i even = _mm256_mul_epu32(a, multiplier);
+        const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), multiplier);
+        low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b10101010);
+        high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0b10101010);
+    }
+
+    // writes the blocks first_block..first_block+7, the low counter word must not wrap within them
+    void generate_8_blocks(uint8_t *out, const uint64_t first_block, const uint64_t stream) const {
+        __m256i counter_0 = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(first_block)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256i counter_1 = _mm256_set1_epi32(static_cast<int>(first_block >> 32));
+        __m256i counter_2 = _mm256_set1_epi32(static_cast<int>(stream));
+        __m256i counter_3 = _mm256_set1_epi32(static_cast<int>(stream >> 32));
+        const __m256i multiplier_0_vector = _mm256_set1_epi32(static_cast<int>(multiplier_0));
+        const __m256i multiplier_1_vector = _mm256_set1_epi32(static_cast<int>(multiplier_1));
+        uint32_t round_key_0 = key_0;
+        uint32_t round_key_1 = key_1;
+
+        for (int round = 0; round < rounds; ++round) {
+            __m256i high_0, low_0, high_1, low_1;
+            multiply_high_low(counter_0, multiplier_0_vector, high_0, low_0);
+            multiply_high_low(counter_2, multiplier_1_vector, high_1, low_1);
+            counter_0 = _mm256_xor_si256(_mm256_xor_si256(high_1, counter_1), _mm256_set1_epi32(static_cast<int>(round_key_0)));
+            counter_1 = low_1;
+            counter_2 = _mm256_xor_si256(_mm256_xor_si256(high_0, counter_3), _mm256_set1_epi32(static_cast<int>(round_key_1)));
+            counter_3 = low_0;
+            round_key_0 += weyl_0;
+            round_key_1 += weyl_1;
+        }
+
+        // transpose from one word per register to one block per 128-bit lane
+        const __m256i words_01_low = _mm256_unpacklo_epi32(counter_0, counter_1);
+        const __m256i words_23_low = _mm256_unpacklo_epi32(counter_2, counter_3);
+        const __m256i words_01_high = _mm256_unpackhi_epi32(counter_0, counter_1);
+        const __m256i words_23_high = _mm256_unpackhi_epi32(counter_2, counter_3);
+        const __m256i blocks_0_4 = _mm256_unpacklo_epi64(words_01_low, words_23_low);
+        const __m256i blocks_1_5 = _mm256_unpackhi_epi64(words_01_low, words_23_low);
+        const __m256i blocks_2_6 = _mm256_unpacklo_epi64(words_01_high, words_23_high);
+        const __m256i blocks_3_7 = _mm256_unpackhi_epi64(words_01_high, words_23_high);
+        auto *out_vector = reinterpret_cast<__m256i *>(out);
+        _mm256_storeu_si256(out_vector, _mm256_permute2x128_si256(blocks_0_4, blocks_1_5, 0x20));
+        _mm256_storeu_si256(out_vector + 1, _mm256_permute2x128_si256(blocks_2_6, blocks_3_7, 0x20));
+        _mm256_storeu_si256(out_vector + 2, _mm256_permute2x128_si256(blocks_0_4, blocks_1_5, 0x31));
+        _mm256_storeu_si256(out_vector + 3, _mm256_permute2x128_si256(blocks_2_6, blocks_3_7, 0x31));
+    }
+#endif
+
+#ifdef __AVX512F__
+// GCC 12 reports the undefined pass-through operand of the unmasked AVX-512 intrinsics as uninitialized once they are
+// inlined. The LTO link does not see these pragmas, CMakeLists.txt silences the warning there.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    static void multiply_high_low(const __m512i a, const __m512i multiplier, __m512i &high, __m512i &low) {
+        const __m512i even = _mm512_mul_epu32(a, multiplier);
+        const __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), multiplier);
+        low = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+        high = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+    }
+
+    // writes the blocks first_block..first_block+15, the low counter word must not wrap within them
+    void generate_16_blocks(uint8_t *out, const uint64_t first_block, const uint64_t stream) const {
+        __m512i counter_0 = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(first_block)), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+        __m512i counter_1 = _mm512_set1_epi32(static_cast<int>(first_block >> 32));
+        __m512i counter_2 = _mm512_set1_epi32(static_cast<int>(stream));
+        __m512i counter_3 = _mm512_set1_epi32(static_cast<int>(stream >> 32));
+        const __m512i multiplier_0_vector = _mm512_set1_epi32(static_cast<int>(multiplier_0));
+        const __m512i multiplier_1_vector = _mm512_set1_epi32(static_cast<int>(multiplier_1));
+        uint32_t round_key_0 = key_0;
+        uint32_t round_key_1 = key_1;
+
+        for (int round = 0; round < rounds; ++round) {
+            __m512i high_0, low_0, high_1, low_1;
+            multiply_high_low(counter_0, multiplier_0_vector, high_0, low_0);
+            multiply_high_low(counter_2, multiplier_1_vector, high_1, low_1);
+            counter_0 = _mm512_ternarylogic_epi32(high_1, counter_1, _mm512_set1_epi32(static_cast<int>(round_key_0)), 0x96);
+            counter_1 = low_1;
+            counter_2 = _mm512_ternarylogic_epi32(high_0, counter_3, _mm512_set1_epi32(static_cast<int>(round_key_1)), 0x96);
+            counter_3 = low_0;
+            round_key_0 += weyl_0;
+            round_key_1 += weyl_1;
+        }
+
+        // blocks_a_b_c_d holds the blocks a, b, c and d in its four 128-bit lanes
+        const __m512i words_01_low = _mm512_unpacklo_epi32(counter_0, counter_1);
+        const __m512i words_23_low = _mm512_unpacklo_epi32(counter_2, counter_3);
+        const __m512i words_01_high = _mm512_unpackhi_epi32(counter_0, counter_1);
+        const __m512i words_23_high = _mm512_unpackhi_epi32(counter_2, counter_3);
+        const __m512i blocks_0_4_8_12 = _mm512_unpacklo_epi64(words_01_low, words_23_low);
+        const __m512i blocks_1_5_9_13 = _mm512_unpackhi_epi64(words_01_low, words_23_low);
+        const __m512i blocks_2_6_10_14 = _mm512_unpacklo_epi64(words_01_high, words_23_high);
+        const __m512i blocks_3_7_11_15 = _mm512_unpackhi_epi64(words_01_high, words_23_high);
+        const __m512i blocks_0_4_1_5 = _mm512_shuffle_i32x4(blocks_0_4_8_12, blocks_1_5_9_13, 0x44);
+        const __m512i blocks_2_6_3_7 = _mm512_shuffle_i32x4(blocks_2_6_10_14, blocks_3_7_11_15, 0x44);
+        const __m512i blocks_8_12_9_13 = _mm512_shuffle_i32x4(blocks_0_4_8_12, blocks_1_5_9_13, 0xEE);
+        const __m512i blocks_10_14_11_15 = _mm512_shuffle_i32x4(blocks_2_6_10_14, blocks_3_7_11_15, 0xEE);
+        _mm512_storeu_si512(out, _mm512_shuffle_i32x4(blocks_0_4_1_5, blocks_2_6_3_7, 0x88));
+        _mm512_storeu_si512(out + 64, _mm512_shuffle_i32x4(blocks_0_4_1_5, blocks_2_6_3_7, 0xDD));
+        _mm512_storeu_si512(out + 128, _mm512_shuffle_i32x4(blocks_8_12_9_13, blocks_10_14_11_15, 0x88));
+        _mm512_storeu_si512(out + 192, _mm512_shuffle_i32x4(blocks_8_12_9_13, blocks_10_14_11_15, 0xDD));
+    }
+#pragma GCC diagnostic pop
+#endif
+
+    [[nodiscard]] static bool low_counter_wraps(const uint64_t first_block, const uint32_t num_blocks) {
+        return static_cast<uint32_t>(first_block) > UINT32_MAX - (num_blocks - 1);
+    }
+
+public:
+    static constexpr size_t block_size = 4 * sizeof(uint32_t);
+
+    explicit Philox4x32(const uint64_t seed) : key_0(static_cast<uint32_t>(seed)), key_1(static_cast<uint32_t>(seed >> 32)) {}
+
+    [[nodiscard]] std::array<uint32_t, 4> generate_block(const uint64_t block, const uint64_t stream = 0) const {
+        std::array<uint32_t, 4> counter = {static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)};
+        uint32_t round_key_0 = key_0;
+        uint32_t round_key_1 = key_1;
+        for (int round = 0; round < rounds; ++round) {
+            const uint64_t product_0 = static_cast<uint64_t>(multiplier_0) * counter[0];
+            const uint64_t product_1 = static_cast<uint64_t>(multiplier_1) * counter[2];
+            counter = {static_cast<uint32_t>(product_1 >> 32) ^ counter[1] ^ round_key_0, static_cast<uint32_t>(product_1),
+                       static_cast<uint32_t>(product_0 >> 32) ^ counter[3] ^ round_key_1, static_cast<uint32_t>(product_0)};
+            round_key_0 += weyl_0;
+            round_key_1 += weyl_1;
+        }
+        return counter;
+    }
+
+    // writes the blocks first_block..first_block+num_blocks-1 of the given stream to out
+    void fill(void *out, const uint64_t first_block, const size_t num_blocks, const uint64_t stream = 0) const {
+        auto *bytes = static_cast<uint8_t *>(out);
+        size_t i = 0;
+#ifdef __AVX512F__
+        for (const size_t vector_end = num_blocks / 16 * 16; i < vector_end; i += 16) {
+            if (low_counter_wraps(first_block + i, 16)) {
+                break;
+            }
+            generate_16_blocks(bytes + i * block_size, first_block + i, stream);
+        }
+#endif
+#ifdef __AVX2__
+        for (const size_t vector_end = num_blocks / 8 * 8; i < vector_end; i += 8) {
+            if (low_counter_wraps(first_block + i, 8)) {
+                break;
+            }
+            generate_8_blocks(bytes + i * block_size, first_block + i, stream);
+        }
+#endif
+        for (; i < num_blocks; ++i) {
+            const auto block = generate_block(first_block + i, stream);
+            std::memcpy(bytes + i * block_size, block.data(), block_size);
+        }
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "tuple-generator/BatchedTupleGenerator.hpp"
+#include "tuple-generator/KeyDistribution.hpp"
+#include "tuple-source/TupleSource.hpp"
+
+// Synthetic input from one Philox stream, a source starting at first_tuple continues the stream at exactly that tuple.
+// Sources over disjoint ranges (e.g. morsels or per-thread splits) therefore together generate exactly the tuples of
+// the relation, however it is split between threads.
+template<typename T, size_t batch_size = 2048>
+class GeneratedRelation {
+    size_t num_tuples;
+    KeyDistribution key_distribution;
+    uint64_t seed;
+
+public:
+    using Source = BatchedTupleGenerator<T, batch_size>;
+
+    explicit GeneratedRelation(const size_t num_tuples, const KeyDistribution &key_distribution = {}, const uint64_t seed = std::random_device{}())
+        : num_tuples(num_tuples), key_distribution(key_distribution), seed(seed) {
+    }
+
+    [[nodiscard]] size_t get_num_tuples() const {
+        return num_tuples;
+    }
+
+    [[nodiscard]] Source create_source(const size_t first_tuple, const size_t num_tuples_of_source) const {
+        Source source(num_tuples_of_source, key_distribution, seed);
+        source.seek_tuple(first_tuple);
+        return source;
+    }
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <fcntl.h>
+#include <memory>
+#include <span>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+#include "tuple-source/TupleSource.hpp"
+
+// Hands out views of a range of the mapped relation, no tuple is copied by next_batch.
+template<typename T, size_t batch_size = 2048>
+class MmapTupleSource {
+    std::shared_ptr<const T[]> data;
+    size_t next_tuple;
+    size_t end_tuple;
+
+public:
+    MmapTupleSource(std::shared_ptr<const T[]> data, const size_t first_tuple, const size_t num_tuples) : data(std::move(data)), next_tuple(first_tuple), end_tuple(first_tuple + num_tuples) {
+    }
+
+    auto next_batch(const size_t max_tuples = batch_size) -> std::span<const T> {
+        const auto length = std::min({batch_size, max_tuples, end_tuple - next_tuple});
+        const std::span<const T> batch(data.get() + next_tuple, length);
+        next_tuple += length;
+        return batch;
+    }
+
+    size_t fill(const std::span<T> out) {
+        const auto length = std::min(out.size(), end_tuple - next_tuple);
+        std::copy_n(data.get() + next_tuple, length, out.data());
+        next_tuple += length;
+        return length;
+    }
+
+    auto static getBatchSize() {
+        return batch_size;
+    }
+};
+
+// Binary file of densely packed tuples, mapped read-only. With populate the whole file is faulted in by mmap
+// (MAP_POPULATE), otherwise the kernel is asked to read ahead sequentially.
+template<typename T, size_t batch_size = 2048>
+class MmapRelation {
+    static_assert(std::is_trivially_copyable_v<T>, "Tuples are read as raw bytes");
+    std::shared_ptr<const T[]> data;
+    size_t num_tuples = 0;
+
+public:
+    using Source = MmapTupleSource<T, batch_size>;
+
+    explicit MmapRelation(const std::string &filepath, const bool populate = true) {
+        const int fd = open(filepath.c_str(), O_RDONLY);
+        if (fd == -1) {
+            relation_io_failure("Failed to open file: ", filepath);
+        }
+        struct stat sb {};
+        if (fstat(fd, &sb) == -1) {
+            close(fd);
+            relation_io_failure("Failed to get file size: ", filepath);
+        }
+        num_tuples = static_cast<size_t>(sb.st_size) / sizeof(T);
+        if (num_tuples == 0) {
+            close(fd);
+            return;
+        }
+
+        const size_t size = num_tuples * sizeof(T);
+        void *mapped_data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | (populate ? MAP_POPULATE : 0), fd, 0);
+        close(fd);
+        if (mapped_data == MAP_FAILED) {
+            relation_io_failure("Failed to map file: ", filepath);
+        }
+        madvise(mapped_data, size, MADV_SEQUENTIAL);
+        if (!populate) {
+            madvise(mapped_data, size, MADV_WILLNEED);
+        }
+        data = std::shared_ptr<const T[]>(static_cast<const T *>(mapped_data), [size](const T *ptr) {
+            munmap(const_cast<T *>(ptr), size);
+        });
+    }
+
+    [[nodiscard]] size_t get_num_tuples() const {
+        return num_tuples;
+    }
+
+    [[nodiscard]] Source create_source(const size_t first_tuple, const size_t num_tuples_of_source) const {
+        return Source(data, first_tuple, num_tuples_of_source);
+    }
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <memory>
+#include <span>
+#include <string>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+#include "tuple-source/TupleSource.hpp"
+
+// Streams a range of the relation with positioned reads, so the threads share one file descriptor without seeking.
+// fill reads straight into the caller's memory, next_batch reads into a buffer of batch_size tuples.
+template<typename T, size_t batch_size = 2048>
+class PreadTupleSource {
+    std::shared_ptr<const int> fd;
+    std::unique_ptr<T[]> buffer;
+    size_t next_tuple;
+    size_t end_tuple;
+
+    void read_tuples(T *out, const size_t count) {
+        auto *bytes = reinterpret_cast<char *>(out);
+        size_t remaining = count * sizeof(T);
+        auto offset = static_cast<off_t>(next_tuple * sizeof(T));
+        while (remaining > 0) {
+            const ssize_t read_bytes = pread(*fd, bytes, remaining, offset);
+            if (read_bytes < 0 && errno == EINTR) {
+                continue;
+            }
+            if (read_bytes <= 0) {
+                relation_io_failure("Failed to read relation");
+            }
+            bytes += read_bytes;
+            offset += read_bytes;
+            remaining -= static_cast<size_t>(read_bytes);
+        }
+        next_tuple += count;
+    }
+
+public:
+    PreadTupleSource(std::shared_ptr<const int> fd, const size_t first_tuple, const size_t num_tuples)
+        : fd(std::move(fd)), buffer(std::make_unique_for_overwrite<T[]>(batch_size)), next_tuple(first_tuple), end_tuple(first_tuple + num_tuples) {
+    }
+
+    auto next_batch(const size_t max_tuples = batch_size) -> std::span<const T> {
+        const auto length = std::min({batch_size, max_tuples, end_tuple - next_tuple});
+        read_tuples(buffer.get(), length);
+        return {buffer.get(), length};
+    }
+
+    size_t fill(const std::span<T> out) {
+        const auto length = std::min(out.size(), end_tuple - next_tuple);
+        read_tuples(out.data(), length);
+        return length;
+    }
+
+    auto static getBatchSize() {
+        return batch_size;
+    }
+};
+
+// Binary file of densely packed tuples that is read on demand instead of being mapped.
+template<typename T, size_t batch_size = 2048>
+class PreadRelation {
+    static_assert(std::is_trivially_copyable_v<T>, "Tuples are read as raw bytes");
+    std::shared_ptr<const int> fd;
+    size_t num_tuples = 0;
+
+public:
+    using Source = PreadTupleSource<T, batch_size>;
+
+    explicit PreadRelation(const std::string &filepath) {
+        const int raw_fd = open(filepath.c_str(), O_RDONLY);
+        if (raw_fd == -1) {
+            relation_io_failure("Failed to open file: ", filepath);
+        }
+        fd = std::shared_ptr<const int>(new int(raw_fd), [](const int *ptr) {
+            close(*ptr);
+            delete ptr;
+        });
+        struct stat sb {};
+        if (fstat(raw_fd, &sb) == -1) {
+            relation_io_failure("Failed to get file size: ", filepath);
+        }
+        num_tuples = static_cast<size_t>(sb.st_size) / sizeof(T);
+        posix_fadvise(raw_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+
+    [[nodiscard]] size_t get_num_tuples() const {
+        return num_tuples;
+    }
+
+    [[nodiscard]] Source create_source(const size_t first_tuple, const size_t num_tuples_of_source) const {
+        return Source(fd, first_tuple, num_tuples_of_source);
+    }
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <string>
+
+// A TupleSource hands out the tuples of one thread, either as a view of its own buffer (next_batch) or by writing
+// them into caller-owned memory (fill). Both return no tuples once the source is exhausted.
+template<typename S, typename T>
+concept TupleSource = requires(S source, std::span<T> out) {
+    { source.next_batch() } -> std::same_as<std::span<const T>>;
+    { source.fill(out) } -> std::same_as<size_t>;
+    { S::getBatchSize() } -> std::convertible_to<size_t>;
+};
+
+// A TupleSourceFactory describes the whole input of an orchestrator and splits it into one TupleSource per thread.
+template<typename F, typename T>
+concept TupleSourceFactory = requires(const F factory, size_t first_tuple, size_t num_tuples) {
+    typename F::Source;
+    requires TupleSource<typename F::Source, T>;
+    { factory.get_num_tuples() } -> std::same_as<size_t>;
+    { factory.create_source(first_tuple, num_tuples) } -> std::same_as<typename F::Source>;
+};
+
+// file-backed sources cannot continue without their input, release builds have no exceptions
+[[noreturn]] inline void relation_io_failure(const char *message, const std::string &filepath = {}) {
+    std::fprintf(stderr, "%s%s (%s)\n", message, filepath.c_str(), std::strerror(errno));
+    std::abort();
+}
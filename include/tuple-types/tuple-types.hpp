@@ -19,6 +19,10 @@ public:
     KeyType get_key() const {
         return key;
     }
+
+    void set_key(const KeyType new_key) {
+        key = new_key;
+    }
 };
 
 class Tuple4 : public BenchmarkTuple {
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <immintrin.h>
+
+// Computes value % divisor for 32-bit values with a precomputed 64-bit reciprocal (Lemire et al., "Faster Remainder by Direct Computation").
+class FastModulo {
+    uint64_t reciprocal;
+    uint32_t divisor;
+
+public:
+    constexpr explicit FastModulo(const uint32_t divisor) : reciprocal(UINT64_C(0xFFFFFFFFFFFFFFFF) / divisor + 1), divisor(divisor) {}
+
+    [[nodiscard]] constexpr uint32_t operator()(const uint32_t value) const {
+        const uint64_t lowbits = reciprocal * value;
+        return static_cast<uint32_t>((static_cast<__uint128_t>(lowbits) * divisor) >> 64);
+    }
+
+    [[nodiscard]] constexpr uint32_t get_divisor() const {
+        return divisor;
+    }
+
+#ifdef __AVX2__
+    // values holds one 32-bit value in the lower half of every 64-bit lane, the upper halves are ignored
+    [[nodiscard]] __m256i modulo_epi64_lanes(const __m256i values) const {
+        const __m256i reciprocal_low = _mm256_set1_epi64x(static_cast<int64_t>(reciprocal & 0xFFFFFFFF));
+        const __m256i reciprocal_high = _mm256_set1_epi64x(static_cast<int64_t>(reciprocal >> 32));
+        const __m256i divisor_vector = _mm256_set1_epi64x(divisor);
+
+        const __m256i lowbits = _mm256_add_epi64(_mm256_mul_epu32(values, reciprocal_low), _mm256_slli_epi64(_mm256_mul_epu32(values, reciprocal_high), 32));
+        const __m256i low_product = _mm256_srli_epi64(_mm256_mul_epu32(lowbits, divisor_vector), 32);
+        const __m256i high_product = _mm256_mul_epu32(_mm256_srli_epi64(lowbits, 32), divisor_vector);
+        return _mm256_srli_epi64(_mm256_add_epi64(high_product, low_product), 32);
+    }
+
+    [[nodiscard]] __m128i operator()(const __m128i values) const {
+        const __m256i result = modulo_epi64_lanes(_mm256_cvtepu32_epi64(values));
+        return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(result, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)));
+    }
+
+    [[nodiscard]] __m256i operator()(const __m256i values) const {
+        const __m256i even = modulo_epi64_lanes(values);
+        const __m256i odd = modulo_epi64_lanes(_mm256_srli_epi64(values, 32));
+        return _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+    }
+#endif
+
+#ifdef __AVX512F__
+// the unmasked shifts and multiplies trip the same GCC 12 false positive as Philox4x32
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    [[nodiscard]] __m512i modulo_epi64_lanes(const __m512i values) const {
+        const __m512i reciprocal_low = _mm512_set1_epi64(static_cast<int64_t>(reciprocal & 0xFFFFFFFF));
+        const __m512i reciprocal_high = _mm512_set1_epi64(static_cast<int64_t>(reciprocal >> 32));
+        const __m512i divisor_vector = _mm512_set1_epi64(divisor);
+
+        const __m512i lowbits = _mm512_add_epi64(_mm512_mul_epu32(values, reciprocal_low), _mm512_slli_epi64(_mm512_mul_epu32(values, reciprocal_high), 32));
+        const __m512i low_product = _mm512_srli_epi64(_mm512_mul_epu32(lowbits, divisor_vector), 32);
+        const __m512i high_product = _mm512_mul_epu32(_mm512_srli_epi64(lowbits, 32), divisor_vector);
+        return _mm512_srli_epi64(_mm512_add_epi64(high_product, low_product), 32);
+    }
+
+    [[nodiscard]] __m512i operator()(const __m512i values) const {
+        const __m512i even = modulo_epi64_lanes(values);
+        const __m512i odd = modulo_epi64_lanes(_mm512_srli_epi64(values, 32));
+        return _mm512_or_si512(even, _mm512_slli_epi64(odd, 32));
+    }
+#pragma GCC diagnostic pop
+#endif
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+// Far above any array of a shuffle, but small enough that GCC can drop the overflow path of new[]. That path passes
+// SIZE_MAX to operator new[], which -Walloc-size-larger-than reports wherever the count is not bounded.
+inline constexpr size_t max_array_bytes = size_t{1} << 48;
+
+// std::make_unique_for_overwrite<T[]> that aborts for arrays above max_array_bytes, release builds have no exceptions
+template<typename T>
+std::unique_ptr<T[]> make_array_for_overwrite(const size_t count) {
+    if (count > max_array_bytes / sizeof(T)) {
+        std::fprintf(stderr, "Array of %zu elements of %zu bytes is too large\n", count, sizeof(T));
+        std::abort();
+    }
+    return std::make_unique_for_overwrite<T[]>(count);
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sstream>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+// Where the pages of a partition are placed on a NUMA machine.
+enum class NumaPlacement {
+    // first touch, i.e. on the node of whichever thread writes a page first
+    None,
+    // every partition has a home node (partition % nodes) and all of its pages are bound to it
+    HomeNode,
+    // every node owns a current page per partition, threads flush into the pages of the node they run on
+    PerNode,
+};
+
+inline const char *get_numa_placement_name(const NumaPlacement placement) {
+    switch (placement) {
+        case NumaPlacement::None:
+            return "first-touch";
+        case NumaPlacement::HomeNode:
+            return "home-node";
+        case NumaPlacement::PerNode:
+            return "per-node";
+    }
+    return "unknown";
+}
+
+// NUMA nodes and their CPUs as reported by /sys/devices/system/node, without a libnuma dependency.
+// Machines without that directory are treated as a single node.
+class NumaTopology {
+    std::vector<int> node_of_cpu;
+    size_t num_nodes = 1;
+
+    // parses cpu lists like "0-3,8-11"
+    static std::vector<unsigned> parse_cpu_list(const std::string &cpu_list) {
+        std::vector<unsigned> cpus;
+        std::istringstream ranges(cpu_list);
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+            if (range.empty()) {
+                continue;
+            }
+            const auto dash = range.find('-');
+            const auto first = std::strtoul(range.c_str(), nullptr, 10);
+            const auto last = dash == std::string::npos ? first : std::strtoul(range.c_str() + dash + 1, nullptr, 10);
+            for (auto cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(static_cast<unsigned>(cpu));
+            }
+        }
+        return cpus;
+    }
+
+    NumaTopology() {
+        for (size_t node = 0;; ++node) {
+            std::ifstream cpu_list_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!cpu_list_file) {
+                break;
+            }
+            std::string cpu_list;
+            std::getline(cpu_list_file, cpu_list);
+            for (const auto cpu: parse_cpu_list(cpu_list)) {
+                if (cpu >= node_of_cpu.size()) {
+                    node_of_cpu.resize(cpu + 1, 0);
+                }
+                node_of_cpu[cpu] = static_cast<int>(node);
+            }
+            num_nodes = node + 1;
+        }
+    }
+
+    static const NumaTopology &get() {
+        static const NumaTopology topology;
+        return topology;
+    }
+
+public:
+    [[nodiscard]] static size_t get_num_nodes() {
+        return get().num_nodes;
+    }
+
+    [[nodiscard]] static int get_node_of_cpu(const unsigned cpu) {
+        const auto &node_of_cpu = get().node_of_cpu;
+        return cpu < node_of_cpu.size() ? node_of_cpu[cpu] : 0;
+    }
+
+    // node of the CPU the calling thread currently runs on, only stable for pinned threads
+    [[nodiscard]] static int get_current_node() {
+        if (get_num_nodes() == 1) {
+            return 0;
+        }
+        const int cpu = sched_getcpu();
+        return cpu < 0 ? 0 : get_node_of_cpu(static_cast<unsigned>(cpu));
+    }
+
+    // prefers the given node for all pages of [memory, memory + bytes) that are not faulted in yet,
+    // memory has to be page aligned
+    static bool bind_memory(void *memory, const size_t bytes, const int node) {
+        if (node < 0 || get_num_nodes() == 1) {
+            return false;
+        }
+        constexpr size_t bits_per_mask = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> node_mask(get_num_nodes() / bits_per_mask + 1, 0);
+        node_mask[static_cast<size_t>(node) / bits_per_mask] |= 1ul << (static_cast<size_t>(node) % bits_per_mask);
+        return syscall(__NR_mbind, memory, bytes, MPOL_PREFERRED, node_mask.data(), node_mask.size() * bits_per_mask, 0) == 0;
+    }
+
+    // sum of a counter (e.g. "numa_miss" or "other_node") of /sys/devices/system/node/node*/numastat over all nodes
+    [[nodiscard]] static uint64_t read_numastat(const std::string &counter) {
+        uint64_t sum = 0;
+        for (size_t node = 0; node < get_num_nodes(); ++node) {
+            std::ifstream numastat_file("/sys/devices/system/node/node" + std::to_string(node) + "/numastat");
+            std::string name;
+            uint64_t value;
+            while (numastat_file >> name >> value) {
+                if (name == counter) {
+                    sum += value;
+                }
+            }
+        }
+        return sum;
+    }
+};
@@ -35,5 +35,10 @@ struct alignas(std::hardware_destructive_interference_size) PaddedAtomic {
     void operator|=(unsigned i) {
         value |= i;
     }
+
+    // wakes threads blocked in adaptive_wait on this atomic
+    void notify_all() {
+        value.notify_all();
+    }
 };
 #endif// PADDEDATOMIC_HPP
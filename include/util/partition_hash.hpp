@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <immintrin.h>
+
+// Hash policies applied to the key before it is reduced to a partition id.
+// Every policy provides a scalar overload and, where the instruction set allows it, SIMD overloads
+// for 8 (AVX2) and 16 (AVX-512) keys.
+
+struct IdentityHash {
+    [[nodiscard]] static constexpr uint32_t hash(const uint32_t key) {
+        return key;
+    }
+#ifdef __AVX2__
+    [[nodiscard]] static __m256i hash(const __m256i keys) {
+        return keys;
+    }
+#endif
+#ifdef __AVX512F__
+    [[nodiscard]] static __m512i hash(const __m512i keys) {
+        return keys;
+    }
+#endif
+};
+
+// CRC32-C of the key. There is no vector CRC instruction, the SIMD overloads hash lane by lane.
+struct Crc32Hash {
+    [[nodiscard]] static uint32_t hash(const uint32_t key) {
+#ifdef __SSE4_2__
+        return _mm_crc32_u32(0, key);
+#else
+        uint32_t crc = key;
+        for (int i = 0; i < 32; ++i) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+        }
+        return crc;
+#endif
+    }
+#ifdef __AVX2__
+    [[nodiscard]] static __m256i hash(const __m256i keys) {
+        alignas(32) uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), keys);
+        for (auto &lane: lanes) {
+            lane = hash(lane);
+        }
+        return _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes));
+    }
+#endif
+#ifdef __AVX512F__
+    [[nodiscard]] static __m512i hash(const __m512i keys) {
+        alignas(64) uint32_t lanes[16];
+        _mm512_store_si512(lanes, keys);
+        for (auto &lane: lanes) {
+            lane = hash(lane);
+        }
+        return _mm512_load_si512(lanes);
+    }
+#endif
+};
+
+// Multiply-shift hashing with the 64-bit golden ratio, keeps the upper 32 bits of the product.
+struct FibonacciHash {
+    static constexpr uint64_t multiplier = 0x9E3779B97F4A7C15;
+
+    [[nodiscard]] static constexpr uint32_t hash(const uint32_t key) {
+        return static_cast<uint32_t>((key * multiplier) >> 32);
+    }
+#ifdef __AVX2__
+    // keys holds one key in the lower half of every 64-bit lane, the result is in the lower half as well
+    [[nodiscard]] static __m256i hash_epi64_lanes(const __m256i keys) {
+        const __m256i low_product = _mm256_mul_epu32(keys, _mm256_set1_epi64x(multiplier & 0xFFFFFFFF));
+        const __m256i high_product = _mm256_mul_epu32(keys, _mm256_set1_epi64x(multiplier >> 32));
+        return _mm256_add_epi64(_mm256_srli_epi64(low_product, 32), high_product);
+    }
+
+    [[nodiscard]] static __m256i hash(const __m256i keys) {
+        const __m256i even = hash_epi64_lanes(keys);
+        const __m256i odd = hash_epi64_lanes(_mm256_srli_epi64(keys, 32));
+        return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0b10101010);
+    }
+#endif
+#ifdef __AVX512F__
+// the unmasked shifts trip the same GCC 12 false positive as FastModulo
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    [[nodiscard]] static __m512i hash_epi64_lanes(const __m512i keys) {
+        const __m512i low_product = _mm512_mul_epu32(keys, _mm512_set1_epi64(multiplier & 0xFFFFFFFF));
+        const __m512i high_product = _mm512_mul_epu32(keys, _mm512_set1_epi64(multiplier >> 32));
+        return _mm512_add_epi64(_mm512_srli_epi64(low_product, 32), high_product);
+    }
+
+    [[nodiscard]] static __m512i hash(const __m512i keys) {
+        const __m512i even = hash_epi64_lanes(keys);
+        const __m512i odd = hash_epi64_lanes(_mm512_srli_epi64(keys, 32));
+        return _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+    }
+#pragma GCC diagnostic pop
+#endif
+};
+
+// Finalizer of MurmurHash3 (fmix32).
+struct MurmurHash {
+    [[nodiscard]] static constexpr uint32_t hash(uint32_t key) {
+        key ^= key >> 16;
+        key *= 0x85EBCA6B;
+        key ^= key >> 13;
+        key *= 0xC2B2AE35;
+        key ^= key >> 16;
+        return key;
+    }
+#ifdef __AVX2__
+    [[nodiscard]] static __m256i hash(__m256i keys) {
+        keys = _mm256_xor_si256(keys, _mm256_srli_epi32(keys, 16));
+        keys = _mm256_mullo_epi32(keys, _mm256_set1_epi32(static_cast<int>(0x85EBCA6B)));
+        keys = _mm256_xor_si256(keys, _mm256_srli_epi32(keys, 13));
+        keys = _mm256_mullo_epi32(keys, _mm256_set1_epi32(static_cast<int>(0xC2B2AE35)));
+        return _mm256_xor_si256(keys, _mm256_srli_epi32(keys, 16));
+    }
+#endif
+#ifdef __AVX512F__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    [[nodiscard]] static __m512i hash(__m512i keys) {
+        keys = _mm512_xor_si512(keys, _mm512_srli_epi32(keys, 16));
+        keys = _mm512_mullo_epi32(keys, _mm512_set1_epi32(static_cast<int>(0x85EBCA6B)));
+        keys = _mm512_xor_si512(keys, _mm512_srli_epi32(keys, 13));
+        keys = _mm512_mullo_epi32(keys, _mm512_set1_epi32(static_cast<int>(0xC2B2AE35)));
+        return _mm512_xor_si512(keys, _mm512_srli_epi32(keys, 16));
+    }
+#pragma GCC diagnostic pop
+#endif
+};
@@ -1,18 +1,24 @@
 #pragma once
 
 #include <array>
+#include <cassert>
 #include <cstddef>
-#include <cstdlib>
+#include <cstdint>
 #include <immintrin.h>
 
-template<typename T, size_t num_partitions>
+#include "util/FastModulo.hpp"
+#include "util/partition_hash.hpp"
+
+template<typename T, size_t num_partitions, typename PartitionHash = IdentityHash>
 size_t partition_function(const T &entry) {
     constexpr static size_t mask = num_partitions - 1;
     constexpr static bool is_power_of_2 = (num_partitions & mask) == 0;
+    const uint32_t key = PartitionHash::hash(entry.get_key());
     if constexpr (is_power_of_2) {
-        return entry.get_key() & mask;
+        return key & mask;
     }
-    return entry.get_key() % num_partitions;
+    constexpr static FastModulo fast_modulo(num_partitions);
+    return fast_modulo(key);
 }
 template<typename T>
 size_t partition_function(T &entry, size_t num_partitions) {
@@ -23,26 +29,163 @@ size_t partition_function(T &entry, size_t num_partitions) {
     return entry % num_partitions;
 }
 
+class PartitionMask {
+    uint32_t mask;
 
-template<typename T, size_t num_partitions>
-__m128i partition_function_simd(const T *entry) {
+public:
+    constexpr explicit PartitionMask(const uint32_t num_partitions) : mask(num_partitions - 1) {}
+
+    [[nodiscard]] constexpr uint32_t operator()(const uint32_t value) const {
+        return value & mask;
+    }
+#ifdef __AVX2__
+    [[nodiscard]] __m256i operator()(const __m256i values) const {
+        return _mm256_and_si256(values, _mm256_set1_epi32(static_cast<int>(mask)));
+    }
+#endif
+#ifdef __AVX512F__
+    [[nodiscard]] __m512i operator()(const __m512i values) const {
+        return _mm512_and_si512(values, _mm512_set1_epi32(static_cast<int>(mask)));
+    }
+#endif
+};
+
+// the key is the first 4 bytes of every tuple, wider tuples are gathered with a stride of sizeof(T)
+#ifdef __AVX2__
+template<typename T>
+__m256i load_keys_avx2(const T *entries) {
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Tuple size must be a multiple of the key size");
+    constexpr int stride = sizeof(T) / sizeof(uint32_t);
+    if constexpr (stride == 1) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(entries));
+    } else {
+        const __m256i offsets = _mm256_setr_epi32(0, stride, 2 * stride, 3 * stride, 4 * stride, 5 * stride, 6 * stride, 7 * stride);
+        return _mm256_i32gather_epi32(reinterpret_cast<const int *>(entries), offsets, sizeof(uint32_t));
+    }
+}
+#endif
+#ifdef __AVX512F__
+// the gather and the narrowing conversion start from an undefined vector, which GCC 12 reports once they are inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+template<typename T>
+__m512i load_keys_avx512(const T *entries) {
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Tuple size must be a multiple of the key size");
+    constexpr int stride = sizeof(T) / sizeof(uint32_t);
+    if constexpr (stride == 1) {
+        return _mm512_loadu_si512(entries);
+    } else {
+        const __m512i offsets = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(stride));
+        return _mm512_i32gather_epi32(offsets, entries, sizeof(uint32_t));
+    }
+}
+#pragma GCC diagnostic pop
+#endif
+
+template<typename PartitionHash, typename T, typename Reduction>
+void compute_partition_ids(const T *entries, const size_t count, uint16_t *partition_ids, const Reduction &reduce) {
+    size_t i = 0;
+#ifdef __AVX512F__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    for (; i + 16 <= count; i += 16) {
+        const __m512i ids = reduce(PartitionHash::hash(load_keys_avx512(entries + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(partition_ids + i), _mm512_cvtepi32_epi16(ids));
+    }
+#pragma GCC diagnostic pop
+#endif
+#ifdef __AVX2__
+    for (; i + 8 <= count; i += 8) {
+        const __m256i ids = reduce(PartitionHash::hash(load_keys_avx2(entries + i)));
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(ids, ids), 0b00001000);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(partition_ids + i), _mm256_castsi256_si128(packed));
+    }
+#endif
+    for (; i < count; ++i) {
+        partition_ids[i] = static_cast<uint16_t>(reduce(PartitionHash::hash(entries[i].get_key())));
+    }
+}
+
+// writes the partition of entries[0..count) to partition_ids[0..count)
+template<typename T, size_t num_partitions, typename PartitionHash = IdentityHash>
+void partition_function_batch(const T *entries, const size_t count, uint16_t *partition_ids) {
+    static_assert(num_partitions <= UINT16_MAX + 1, "Partition ids must fit into 16 bits");
     constexpr static size_t mask = num_partitions - 1;
     constexpr static bool is_power_of_2 = (num_partitions & mask) == 0;
     if constexpr (is_power_of_2) {
-        if constexpr (T::get_size_of_variable_data() == 0) {
-            const __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(entry));
-            const __m128i mask_vector = _mm_set1_epi32(mask);
-            return _mm_and_si128(keys, mask_vector);
+        compute_partition_ids<PartitionHash>(entries, count, partition_ids, PartitionMask(num_partitions));
+    } else {
+        constexpr static FastModulo fast_modulo(num_partitions);
+        compute_partition_ids<PartitionHash>(entries, count, partition_ids, fast_modulo);
+    }
+}
+
+template<typename PartitionHash = IdentityHash>
+class RuntimePartitionFunction {
+    size_t num_partitions;
+    size_t mask;
+    bool is_power_of_2;
+    FastModulo fast_modulo;
+
+public:
+    explicit RuntimePartitionFunction(const size_t num_partitions) : num_partitions(num_partitions), mask(num_partitions - 1), is_power_of_2((num_partitions & mask) == 0), fast_modulo(num_partitions) {}
+
+    template<typename T>
+    size_t operator()(const T &entry) const {
+        const uint32_t key = PartitionHash::hash(entry.get_key());
+        if (is_power_of_2) {
+            return key & mask;
+        }
+        return fast_modulo(key);
+    }
+
+    template<typename T>
+    void operator()(const T *entries, const size_t count, uint16_t *partition_ids) const {
+        assert(num_partitions <= UINT16_MAX + 1);
+        if (is_power_of_2) {
+            compute_partition_ids<PartitionHash>(entries, count, partition_ids, PartitionMask(num_partitions));
         } else {
-            alignas(16) std::array<int, 4> keys{};
-            for (int i = 0; i < 4; ++i) {
-                keys[i] = entry[i].get_key();
-            }
-            const __m128i keys_vector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys.data()));
-            const __m128i mask_vector = _mm_set1_epi32(static_cast<int>(mask));
-            return _mm_and_si128(keys_vector, mask_vector);
+            compute_partition_ids<PartitionHash>(entries, count, partition_ids, fast_modulo);
         }
     }
 
-    exit(2);
-}
\ No newline at end of file
+    [[nodiscard]] size_t get_partition_count() const {
+        return num_partitions;
+    }
+};
+
+
+template<typename T, size_t num_partitions>
+__m128i partition_function_simd(const T *entry) {
+    constexpr static size_t mask = num_partitions - 1;
+    constexpr static bool is_power_of_2 = (num_partitions & mask) == 0;
+    __m128i keys_vector;
+    if constexpr (T::get_size_of_variable_data() == 0) {
+        keys_vector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(entry));
+    } else {
+        alignas(16) std::array<int, 4> keys{};
+        for (int i = 0; i < 4; ++i) {
+            keys[i] = entry[i].get_key();
+        }
+        keys_vector = _mm_load_si128(reinterpret_cast<const __m128i *>(keys.data()));
+    }
+
+    if constexpr (is_power_of_2) {
+        const __m128i mask_vector = _mm_set1_epi32(static_cast<int>(mask));
+        return _mm_and_si128(keys_vector, mask_vector);
+    } else {
+        constexpr static FastModulo fast_modulo(num_partitions);
+#ifdef __AVX2__
+        return fast_modulo(keys_vector);
+#else
+        alignas(16) std::array<unsigned, 4> keys{};
+        _mm_store_si128(reinterpret_cast<__m128i *>(keys.data()), keys_vector);
+        for (auto &key: keys) {
+            key = fast_modulo(key);
+        }
+        return _mm_load_si128(reinterpret_cast<const __m128i *>(keys.data()));
+#endif
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+// Peak resident set size of the process (VmHWM), 0 if /proc is not available.
+inline size_t get_peak_rss_bytes() {
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.starts_with("VmHWM:")) {
+            return std::stoull(line.substr(6)) * 1024;
+        }
+    }
+    return 0;
+}
+
+// Lowers the peak RSS to the current RSS (Linux 4.0+), so get_peak_rss_bytes covers only what runs afterwards instead
+// of the whole process lifetime.
+inline void reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <sys/mman.h>
+
+// Hands the memory pages that lie completely within [begin, end) back to the kernel, the rest of the range is left
+// alone. The released part reads as zeros afterwards, so only use it on data that is not read again.
+inline void release_memory_range(const void *begin, const void *end) {
+    constexpr uintptr_t page_size = 4096;
+    const auto first_page = (reinterpret_cast<uintptr_t>(begin) + page_size - 1) & ~(page_size - 1);
+    const auto last_page = reinterpret_cast<uintptr_t>(end) & ~(page_size - 1);
+    if (first_page < last_page) {
+        madvise(reinterpret_cast<void *>(first_page), last_page - first_page, MADV_DONTNEED);
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <sched.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "util/numa/NumaTopology.hpp"
+
+struct CpuInfo {
+    unsigned cpu;
+    unsigned package;
+    // core_id is only unique within a package
+    unsigned core;
+    // shared L3 cache, i.e. the CCX on AMD Zen
+    unsigned l3;
+    int node;
+    // 0 for the first hardware thread of a physical core, 1 for its SMT sibling, ...
+    unsigned smt_index;
+};
+
+// CPUs the process may run on (sched_getaffinity) with their package, core and L3 as reported by
+// /sys/devices/system/cpu. CPUs without an L3 entry are grouped by package.
+class CpuTopology {
+    std::vector<CpuInfo> cpus;
+    std::vector<std::vector<unsigned>> l3_groups;
+    size_t num_physical_cores = 0;
+
+    static unsigned read_id(const std::string &path, const unsigned fallback) {
+        std::ifstream file(path);
+        long id;
+        if (file >> id && id >= 0) {
+            return static_cast<unsigned>(id);
+        }
+        return fallback;
+    }
+
+    CpuTopology() {
+        cpu_set_t allowed_cpus;
+        CPU_ZERO(&allowed_cpus);
+        if (sched_getaffinity(0, sizeof(allowed_cpus), &allowed_cpus) != 0) {
+            CPU_SET(0, &allowed_cpus);
+        }
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &allowed_cpus)) {
+                continue;
+            }
+            const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+            const auto package = read_id(path + "/topology/physical_package_id", 0);
+            const auto core = read_id(path + "/topology/core_id", cpu);
+            // L3 ids are unique per package at most, so they are combined with the package
+            const auto l3 = package << 16 | read_id(path + "/cache/index3/id", 0);
+            cpus.push_back({cpu, package, core, l3, NumaTopology::get_node_of_cpu(cpu), 0});
+        }
+
+        std::ranges::sort(cpus, {}, [](const CpuInfo &info) { return std::tuple(info.package, info.l3, info.core, info.cpu); });
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            if (i > 0 && cpus[i].package == cpus[i - 1].package && cpus[i].core == cpus[i - 1].core) {
+                cpus[i].smt_index = cpus[i - 1].smt_index + 1;
+            } else {
+                ++num_physical_cores;
+            }
+            if (i == 0 || cpus[i].l3 != cpus[i - 1].l3) {
+                l3_groups.emplace_back();
+            }
+            l3_groups.back().push_back(cpus[i].cpu);
+        }
+
+        // every L3 group lists the first hardware thread of all of its cores before their SMT siblings
+        for (auto &l3_group: l3_groups) {
+            std::ranges::stable_sort(l3_group, {}, [this](const unsigned cpu) { return get_info(cpu).smt_index; });
+        }
+    }
+
+    [[nodiscard]] const CpuInfo &get_info(const unsigned cpu) const {
+        return *std::ranges::find(cpus, cpu, &CpuInfo::cpu);
+    }
+
+public:
+    static const CpuTopology &get() {
+        static const CpuTopology topology;
+        return topology;
+    }
+
+    // sorted by package, L3, core and CPU number, i.e. SMT siblings are adjacent
+    [[nodiscard]] const std::vector<CpuInfo> &get_cpus() const {
+        return cpus;
+    }
+
+    [[nodiscard]] const std::vector<std::vector<unsigned>> &get_l3_groups() const {
+        return l3_groups;
+    }
+
+    [[nodiscard]] size_t get_num_physical_cores() const {
+        return num_physical_cores;
+    }
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <sched.h>
+#include <vector>
+
+#include "util/topology/CpuTopology.hpp"
+
+// How the threads of an orchestrator are pinned to the CPUs of the machine.
+enum class ThreadPlacement {
+    // not pinned, the scheduler may migrate threads
+    None,
+    // thread i on the i-th CPU in topology order, i.e. SMT siblings and L3 groups are filled one after another
+    Compact,
+    // round-robin over all L3 groups (alternating packages), so every thread gets as much cache as possible
+    Scatter,
+    // one thread per physical core before any SMT sibling is used
+    PhysicalCores,
+    // contiguous blocks of threads per L3 group (CCX), sized like the group, so neighbouring threads share an L3
+    PerL3,
+};
+
+inline const char *get_thread_placement_name(const ThreadPlacement placement) {
+    switch (placement) {
+        case ThreadPlacement::None:
+            return "none";
+        case ThreadPlacement::Compact:
+            return "compact";
+        case ThreadPlacement::Scatter:
+            return "scatter";
+        case ThreadPlacement::PhysicalCores:
+            return "physical-cores";
+        case ThreadPlacement::PerL3:
+            return "per-ccx";
+    }
+    return "unknown";
+}
+
+// Maps thread indices to CPUs according to a ThreadPlacement and pins threads to them.
+// More threads than CPUs wrap around to the first CPU of the placement order.
+class ThreadPinning {
+    static inline ThreadPlacement default_placement = ThreadPlacement::None;
+
+    // all CPUs in the order in which a placement hands them out
+    static std::vector<int> get_cpu_order(const ThreadPlacement placement) {
+        const auto &topology = CpuTopology::get();
+        std::vector<int> order;
+        switch (placement) {
+            case ThreadPlacement::None:
+                break;
+            case ThreadPlacement::Compact:
+                for (const auto &info: topology.get_cpus()) {
+                    order.push_back(static_cast<int>(info.cpu));
+                }
+                break;
+            case ThreadPlacement::PhysicalCores: {
+                auto cpus = topology.get_cpus();
+                std::ranges::stable_sort(cpus, {}, &CpuInfo::smt_index);
+                for (const auto &info: cpus) {
+                    order.push_back(static_cast<int>(info.cpu));
+                }
+                break;
+            }
+            case ThreadPlacement::Scatter: {
+                const auto groups = get_groups_interleaved_by_package();
+                for (size_t i = 0; order.size() < topology.get_cpus().size(); ++i) {
+                    for (const auto *group: groups) {
+                        if (i < group->size()) {
+                            order.push_back(static_cast<int>((*group)[i]));
+                        }
+                    }
+                }
+                break;
+            }
+            case ThreadPlacement::PerL3:
+                for (const auto &group: topology.get_l3_groups()) {
+                    for (const auto cpu: group) {
+                        order.push_back(static_cast<int>(cpu));
+                    }
+                }
+                break;
+        }
+        return order;
+    }
+
+    // L3 groups in the order package 0 group 0, package 1 group 0, package 0 group 1, ...
+    static std::vector<const std::vector<unsigned> *> get_groups_interleaved_by_package() {
+        const auto &topology = CpuTopology::get();
+        std::vector<std::vector<const std::vector<unsigned> *>> groups_per_package;
+        unsigned previous_package = ~0u;
+        for (const auto &group: topology.get_l3_groups()) {
+            const auto package = std::ranges::find(topology.get_cpus(), group.front(), &CpuInfo::cpu)->package;
+            if (groups_per_package.empty() || package != previous_package) {
+                groups_per_package.emplace_back();
+                previous_package = package;
+            }
+            groups_per_package.back().push_back(&group);
+        }
+        std::vector<const std::vector<unsigned> *> groups;
+        for (size_t i = 0; groups.size() < topology.get_l3_groups().size(); ++i) {
+            for (const auto &package_groups: groups_per_package) {
+                if (i < package_groups.size()) {
+                    groups.push_back(package_groups[i]);
+                }
+            }
+        }
+        return groups;
+    }
+
+public:
+    // CPU of every thread, -1 for threads that are not pinned
+    [[nodiscard]] static std::vector<int> get_cpus(const ThreadPlacement placement, const size_t num_threads) {
+        const auto order = get_cpu_order(placement);
+        if (order.empty()) {
+            return std::vector<int>(num_threads, -1);
+        }
+        std::vector<int> cpus(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            cpus[i] = order[i % order.size()];
+        }
+        return cpus;
+    }
+
+    // CPUs of processing units with threads_per_unit threads each. With ThreadPlacement::PerL3 every unit stays
+    // within one L3 group, units are spread over the groups (alternating packages) and share a group only if
+    // there are more units than groups. Other placements hand out CPUs unit after unit.
+    [[nodiscard]] static std::vector<std::vector<int>> get_cpus_of_units(const ThreadPlacement placement, const size_t num_units, const size_t threads_per_unit) {
+        std::vector<std::vector<int>> unit_cpus(num_units);
+        if (placement != ThreadPlacement::PerL3) {
+            const auto cpus = get_cpus(placement, num_units * threads_per_unit);
+            for (size_t unit = 0; unit < num_units; ++unit) {
+                unit_cpus[unit].assign(cpus.begin() + static_cast<std::ptrdiff_t>(unit * threads_per_unit), cpus.begin() + static_cast<std::ptrdiff_t>((unit + 1) * threads_per_unit));
+            }
+            return unit_cpus;
+        }
+
+        const auto groups = get_groups_interleaved_by_package();
+        std::vector<size_t> next_cpu_of_group(groups.size(), 0);
+        for (size_t unit = 0; unit < num_units; ++unit) {
+            const auto group = unit % groups.size();
+            for (size_t thread = 0; thread < threads_per_unit; ++thread) {
+                const auto &cpus = *groups[group];
+                unit_cpus[unit].push_back(static_cast<int>(cpus[next_cpu_of_group[group]++ % cpus.size()]));
+            }
+        }
+        return unit_cpus;
+    }
+
+    // no-op for cpu < 0
+    static bool pin_current_thread(const int cpu) {
+        if (cpu < 0) {
+            return false;
+        }
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+    }
+
+    // allows the calling thread to run on all CPUs of the process again
+    static bool unpin_current_thread() {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (const auto &info: CpuTopology::get().get_cpus()) {
+            CPU_SET(info.cpu, &cpu_set);
+        }
+        return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+    }
+
+    // placement of orchestrators that are not given one explicitly, e.g. those created through ShuffleOperator
+    [[nodiscard]] static ThreadPlacement get_default_placement() {
+        return default_placement;
+    }
+
+    static void set_default_placement(const ThreadPlacement placement) {
+        default_placement = placement;
+    }
+};
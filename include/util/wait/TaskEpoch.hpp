@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "util/padded/PaddedAtomic.hpp"
+#include "util/wait/adaptive_wait.hpp"
+
+// Hands one task at a time to a fixed group of workers and tracks when all of them finished it. A task is announced
+// by bumping an epoch and completion is a counter, so unlike a bitmask of finished workers the group size is not
+// limited by the width of an integer. The epoch and the counter live on separate cache lines, so finishing workers
+// do not disturb the ones still waiting for the next task.
+class TaskEpoch {
+    PaddedAtomic<uint64_t> epoch{0};
+    PaddedAtomic<size_t> finished_workers;
+    size_t num_workers;
+
+public:
+    // no task is pending initially, i.e. all workers count as finished
+    explicit TaskEpoch(const size_t num_workers) : finished_workers(num_workers), num_workers(num_workers) {
+    }
+
+    // dispatcher side, returns once every worker finished the last published task
+    void wait_for_workers() const {
+        adaptive_wait(finished_workers.value, [this](const size_t finished) { return finished == num_workers; });
+    }
+
+    // dispatcher side, everything written before is visible to workers that return from wait_for_task
+    void publish() {
+        finished_workers.store(0);
+        epoch.value.fetch_add(1);
+        epoch.notify_all();
+    }
+
+    // worker side, waits for a task newer than seen_epoch and returns its epoch
+    uint64_t wait_for_task(const uint64_t seen_epoch) const {
+        return adaptive_wait(epoch.value, [seen_epoch](const uint64_t current) { return current != seen_epoch; });
+    }
+
+    // worker side, only the last worker of a task wakes the dispatcher
+    void finish() {
+        if (finished_workers.value.fetch_add(1) + 1 == num_workers) {
+            finished_workers.notify_all();
+        }
+    }
+};
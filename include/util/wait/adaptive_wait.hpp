@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <immintrin.h>
+#include <thread>
+
+// Short waits (e.g. for the next batch) stay in the spin phase, so the handoff latency of the busy-waiting version is
+// kept. Long waits park the thread instead of burning a core that other threads or operators could use.
+struct AdaptiveWaitPolicy {
+    static constexpr unsigned spin_iterations = 4096;
+    static constexpr unsigned yield_iterations = 64;
+};
+
+// Waits until condition(value) holds for the value of atomic and returns that value: spins with _mm_pause, then
+// yields, then blocks in atomic.wait (a futex on Linux). Every writer whose change can satisfy the condition has
+// to call atomic.notify_all() afterwards, which is cheap while nobody is parked.
+template<typename T, typename Condition, typename Policy = AdaptiveWaitPolicy>
+T adaptive_wait(const std::atomic<T> &atomic, Condition condition) {
+    T value = atomic.load();
+    for (unsigned i = 0; i < Policy::spin_iterations; ++i) {
+        if (condition(value)) {
+            return value;
+        }
+        _mm_pause();
+        value = atomic.load();
+    }
+    for (unsigned i = 0; i < Policy::yield_iterations; ++i) {
+        if (condition(value)) {
+            return value;
+        }
+        std::this_thread::yield();
+        value = atomic.load();
+    }
+    while (!condition(value)) {
+        atomic.wait(value);
+        value = atomic.load();
+    }
+    return value;
+}
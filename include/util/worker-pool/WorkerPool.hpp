@@ -0,0 +1,206 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+#include "util/topology/ThreadPinning.hpp"
+
+// Long-lived worker threads the orchestrators schedule their per-thread work onto, so that a shuffle that runs once
+// per micro-batch does not create and join its threads every time. Every task of a job gets a worker of its own and
+// all tasks of a job run concurrently, i.e. tasks may wait for each other. The pool grows whenever all workers are
+// busy and keeps its workers until the process exits. Workers stay pinned to their last CPU until a task needs a
+// different one, so runs with the same ThreadPlacement do not call sched_setaffinity again.
+class WorkerPool {
+    struct JobState {
+        std::function<void(size_t)> task;
+        std::atomic<size_t> tasks_left;
+    };
+
+    struct Worker {
+        std::binary_semaphore wake{0};
+        // nullptr stops the worker
+        std::shared_ptr<JobState> job;
+        size_t task_index = 0;
+        int cpu = -1;
+        int pinned_cpu = -1;
+        std::jthread thread;
+    };
+
+    static inline std::atomic<bool> persistent_workers = true;
+    static inline std::mutex idle_callbacks_mutex;
+    static inline std::vector<void (*)()> idle_callbacks;
+
+    std::mutex mutex;
+    std::deque<Worker> workers;
+    std::vector<Worker *> idle_workers;
+
+    WorkerPool() = default;
+
+    // all workers are idle by then, jobs are waited for by their handles
+    ~WorkerPool() {
+        for (auto &worker: workers) {
+            worker.job = nullptr;
+            worker.wake.release();
+        }
+        for (auto &worker: workers) {
+            worker.thread.join();
+        }
+    }
+
+    static WorkerPool &get() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    void work(Worker &worker) {
+        while (true) {
+            worker.wake.acquire();
+            if (!worker.job) {
+                return;
+            }
+            if (worker.cpu != worker.pinned_cpu) {
+                worker.cpu < 0 ? ThreadPinning::unpin_current_thread() : ThreadPinning::pin_current_thread(worker.cpu);
+                worker.pinned_cpu = worker.cpu;
+            }
+            worker.job->task(worker.task_index);
+            {
+                std::lock_guard lock(idle_callbacks_mutex);
+                for (const auto callback: idle_callbacks) {
+                    callback();
+                }
+            }
+
+            const auto job = std::move(worker.job);
+            {
+                std::lock_guard lock(mutex);
+                idle_workers.push_back(&worker);
+            }
+            if (job->tasks_left.fetch_sub(1) == 1) {
+                job->tasks_left.notify_all();
+            }
+        }
+    }
+
+    // prefers an idle worker that is already pinned to cpu, must be called with the mutex held
+    Worker &take_idle_worker(const int cpu) {
+        if (idle_workers.empty()) {
+            auto &worker = workers.emplace_back();
+            worker.thread = std::jthread([this, &worker] { work(worker); });
+            return worker;
+        }
+        auto chosen = idle_workers.end() - 1;
+        for (auto it = idle_workers.begin(); it != idle_workers.end(); ++it) {
+            if ((*it)->pinned_cpu == cpu) {
+                chosen = it;
+                break;
+            }
+        }
+        auto &worker = **chosen;
+        *chosen = idle_workers.back();
+        idle_workers.pop_back();
+        return worker;
+    }
+
+public:
+    // handle of a started job, waits for its tasks on destruction like std::jthread
+    class Job {
+        friend class WorkerPool;
+        std::shared_ptr<JobState> state;
+        std::vector<std::jthread> threads;
+
+    public:
+        Job() = default;
+        Job(Job &&) = default;
+        Job &operator=(Job &&other) noexcept {
+            wait();
+            state = std::move(other.state);
+            threads = std::move(other.threads);
+            return *this;
+        }
+        ~Job() {
+            wait();
+        }
+
+        void wait() {
+            if (state) {
+                for (auto tasks_left = state->tasks_left.load(); tasks_left != 0; tasks_left = state->tasks_left.load()) {
+                    state->tasks_left.wait(tasks_left);
+                }
+                state = nullptr;
+            }
+            threads.clear();
+        }
+    };
+
+    // starts one task per entry of cpus, task i runs on cpus[i] (-1 for unpinned) and gets i as argument
+    [[nodiscard]] static Job start(const std::vector<int> &cpus, std::function<void(size_t)> task) {
+        Job job;
+        if (!persistent_workers.load(std::memory_order_relaxed)) {
+            auto shared_task = std::make_shared<std::function<void(size_t)>>(std::move(task));
+            job.threads.reserve(cpus.size());
+            for (size_t i = 0; i < cpus.size(); ++i) {
+                job.threads.emplace_back([shared_task, i, cpu = cpus[i]] {
+                    ThreadPinning::pin_current_thread(cpu);
+                    (*shared_task)(i);
+                });
+            }
+            return job;
+        }
+        if (cpus.empty()) {
+            return job;
+        }
+
+        job.state = std::make_shared<JobState>(std::move(task), cpus.size());
+        auto &pool = get();
+        std::vector<Worker *> assigned_workers;
+        assigned_workers.reserve(cpus.size());
+        {
+            std::lock_guard lock(pool.mutex);
+            for (size_t i = 0; i < cpus.size(); ++i) {
+                auto &worker = pool.take_idle_worker(cpus[i]);
+                worker.job = job.state;
+                worker.task_index = i;
+                worker.cpu = cpus[i];
+                assigned_workers.push_back(&worker);
+            }
+        }
+        for (auto *worker: assigned_workers) {
+            worker->wake.release();
+        }
+        return job;
+    }
+
+    // like start, but returns once all tasks are done
+    static void run(const std::vector<int> &cpus, std::function<void(size_t)> task) {
+        start(cpus, std::move(task)).wait();
+    }
+
+    // false creates and joins a thread per task instead, i.e. the behaviour without a pool
+    static void set_persistent_workers(const bool enabled) {
+        persistent_workers.store(enabled);
+    }
+
+    // Runs callback on a worker after each of its tasks, before the job counts the task as done, e.g. to release
+    // thread-local caches that an idle worker would keep until the process exits.
+    static void add_idle_callback(void (*callback)()) {
+        std::lock_guard lock(idle_callbacks_mutex);
+        idle_callbacks.push_back(callback);
+    }
+
+    [[nodiscard]] static bool uses_persistent_workers() {
+        return persistent_workers.load();
+    }
+
+    [[nodiscard]] static size_t get_num_workers() {
+        auto &pool = get();
+        std::lock_guard lock(pool.mutex);
+        return pool.workers.size();
+    }
+};
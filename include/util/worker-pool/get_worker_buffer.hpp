@@ -0,0 +1,28 @@
+#pragma once
+
+#include "util/make_array.hpp"
+
+#include <cstddef>
+#include <memory>
+
+// Scratch buffer of the calling thread that outlives a single run, so workers of the WorkerPool allocate and fault in
+// their buffers once instead of on every shuffle. The content is neither initialized nor preserved between calls.
+// Tag distinguishes several buffers of the same type that are in use at the same time.
+template<typename T, typename Tag = void>
+T *get_worker_buffer(const size_t count) {
+    thread_local std::unique_ptr<T[]> buffer;
+    thread_local size_t capacity = 0;
+    if (capacity < count) {
+        buffer = make_array_for_overwrite<T>(count);
+        capacity = count;
+    }
+    return buffer.get();
+}
+
+// Object of the calling thread that outlives a single run, e.g. containers that keep their capacity between shuffles.
+// It is created on first use and keeps the state of its last user, Tag works as for get_worker_buffer.
+template<typename T, typename Tag = void>
+T &get_worker_object() {
+    thread_local std::unique_ptr<T> object = std::make_unique<T>();
+    return *object;
+}
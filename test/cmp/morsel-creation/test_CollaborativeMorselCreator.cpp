@@ -0,0 +1,141 @@
+#include "cmp/morsel-creation/CollaborativeMorselCreator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace {
+// counts the tuples alive in all batches, so the tests see which batches the creator freed
+struct CountedTuple {
+    static inline std::atomic<int64_t> alive = 0;
+    uint64_t key = 0;
+
+    CountedTuple() {
+        alive.fetch_add(1);
+    }
+
+    CountedTuple(const CountedTuple &other) : key(other.key) {
+        alive.fetch_add(1);
+    }
+
+    CountedTuple &operator=(const CountedTuple &) = default;
+
+    ~CountedTuple() {
+        alive.fetch_sub(1);
+    }
+};
+
+// the key of a tuple is its position in the relation
+class SequenceRelation {
+    size_t num_tuples;
+
+public:
+    class Source {
+        size_t next_key;
+        size_t end_key;
+
+    public:
+        Source(const size_t first_tuple, const size_t num_tuples) : next_key(first_tuple), end_key(first_tuple + num_tuples) {
+        }
+
+        static constexpr size_t getBatchSize() {
+            return 64;
+        }
+
+        // CollaborativeMorselCreator only fills its own batches
+        std::span<const CountedTuple> next_batch() {
+            return {};
+        }
+
+        size_t fill(const std::span<CountedTuple> out) {
+            const size_t count = std::min(out.size(), end_key - next_key);
+            for (size_t i = 0; i < count; ++i) {
+                out[i].key = next_key + i;
+            }
+            next_key += count;
+            return count;
+        }
+    };
+
+    explicit SequenceRelation(const size_t num_tuples) : num_tuples(num_tuples) {
+    }
+
+    [[nodiscard]] size_t get_num_tuples() const {
+        return num_tuples;
+    }
+
+    [[nodiscard]] Source create_source(const size_t first_tuple, const size_t num_tuples_of_source) const {
+        return {first_tuple, num_tuples_of_source};
+    }
+};
+
+using Creator = CollaborativeMorselCreator<CountedTuple, SequenceRelation>;
+
+// walks up to max_batches batches and returns the number of tuples, every batch has to continue the keys of the last
+size_t consume(Creator &creator, const size_t max_batches = SIZE_MAX) {
+    auto consumer = creator.get_consumer();
+    size_t next_key = 0;
+    for (size_t batches = 0; batches < max_batches; ++batches) {
+        const auto [batch, batch_size] = consumer.next_batch();
+        if (batch == nullptr) {
+            break;
+        }
+        EXPECT_GT(batch_size, 0);
+        for (size_t i = 0; i < batch_size; ++i) {
+            EXPECT_EQ(batch[i].key, next_key) << "batch " << batches;
+            ++next_key;
+        }
+    }
+    return next_key;
+}
+}// namespace
+
+TEST(CollaborativeMorselCreatorTest, EveryConsumerSeesEveryBatchOnce) {
+    // the last batch is partial
+    constexpr size_t num_tuples = 1000 * SequenceRelation::Source::getBatchSize() + 17;
+    constexpr unsigned num_consumers = 4;
+    {
+        Creator creator(SequenceRelation(num_tuples), num_consumers);
+        std::vector<size_t> consumed(num_consumers, 0);
+        {
+            std::vector<std::jthread> consumers;
+            for (unsigned i = 0; i < num_consumers; ++i) {
+                consumers.emplace_back([&, i] { consumed[i] = consume(creator); });
+            }
+        }
+        for (const auto tuples: consumed) {
+            ASSERT_EQ(tuples, num_tuples);
+        }
+        // the consumers freed every batch, the producer may still hold the buffer it found the input exhausted with
+        ASSERT_LE(CountedTuple::alive.load(), static_cast<int64_t>(SequenceRelation::Source::getBatchSize()));
+    }
+    ASSERT_EQ(CountedTuple::alive.load(), 0);
+}
+
+TEST(CollaborativeMorselCreatorTest, DestructorFreesTheBatchesOfAConsumerThatStopsEarly) {
+    constexpr size_t batch_size = SequenceRelation::Source::getBatchSize();
+    constexpr size_t num_batches = 1000;
+    constexpr unsigned num_consumers = 3;
+    {
+        Creator creator(SequenceRelation(num_batches * batch_size), num_consumers);
+        std::vector<size_t> consumed(num_consumers, 0);
+        {
+            std::vector<std::jthread> consumers;
+            consumers.emplace_back([&] { consumed[0] = consume(creator, 2); });
+            for (unsigned i = 1; i < num_consumers; ++i) {
+                consumers.emplace_back([&, i] { consumed[i] = consume(creator); });
+            }
+        }
+        ASSERT_EQ(consumed[0], 2 * batch_size);
+        for (unsigned i = 1; i < num_consumers; ++i) {
+            ASSERT_EQ(consumed[i], num_batches * batch_size);
+        }
+        // every batch from the second one on still waits for the consumer that stopped
+        ASSERT_GE(CountedTuple::alive.load(), static_cast<int64_t>((num_batches - 1) * batch_size));
+    }
+    ASSERT_EQ(CountedTuple::alive.load(), 0);
+}
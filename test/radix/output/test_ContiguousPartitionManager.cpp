@@ -0,0 +1,94 @@
+#include "radix/orchestration/RadixContiguousOrchestrator.hpp"
+#include "radix/output/ContiguousPartitionManager.hpp"
+#include "radix/worker/process_radix_chunk_contiguous.hpp"
+#include "tuple-types/tuple-types.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+template<typename T, size_t partitions>
+void shuffle_and_check(const PartitionLayout layout, const unsigned num_tuples, const unsigned num_threads) {
+    ContiguousPartitionManager<T, partitions> partition_manager(num_threads, layout);
+    std::vector<T> tuples;
+    for (unsigned i = 0; i < num_tuples; ++i) {
+        if constexpr (T::get_size_of_variable_data() > 0) {
+            std::array<uint32_t, T::get_size_of_variable_data() / sizeof(uint32_t)> data;
+            std::ranges::fill(data, i + 1);
+            tuples.emplace_back(i, data);
+        } else {
+            tuples.emplace_back(i);
+        }
+    }
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned t = 0; t < num_threads; ++t) {
+            const unsigned first = t * num_tuples / num_threads;
+            const unsigned chunk_size = (t + 1) * num_tuples / num_threads - first;
+            threads.emplace_back([&, first, chunk_size] { process_radix_chunk_contiguous<T, partitions>(partition_manager, tuples.data() + first, chunk_size, num_threads); });
+        }
+    }
+
+    const auto written_tuples = partition_manager.get_written_tuples_per_partition();
+    const auto all_tuples = partition_manager.get_all_tuples_per_partition();
+    std::vector<bool> seen(num_tuples, false);
+    for (unsigned partition = 0; partition < partitions; ++partition) {
+        ASSERT_EQ(written_tuples[partition], num_tuples / partitions + (partition < num_tuples % partitions));
+        ASSERT_EQ(all_tuples[partition].size(), written_tuples[partition]);
+        for (const auto &tuple: all_tuples[partition]) {
+            const auto key = tuple.get_key();
+            ASSERT_EQ(key % partitions, partition);
+            if constexpr (T::get_size_of_variable_data() > 0) {
+                for (const auto value: tuple.get_variable_data()) {
+                    ASSERT_EQ(value, key + 1);
+                }
+            }
+            ASSERT_FALSE(seen[key]);
+            seen[key] = true;
+        }
+    }
+}
+
+TEST(ContiguousPartitionManagerTest, RowTuple16) {
+    shuffle_and_check<Tuple16, 32>(PartitionLayout::Row, 100'003, 3);
+}
+
+TEST(ContiguousPartitionManagerTest, PaxTuple4) {
+    shuffle_and_check<Tuple4, 32>(PartitionLayout::Pax, 10'000, 2);
+}
+
+TEST(ContiguousPartitionManagerTest, PaxTuple100) {
+    shuffle_and_check<Tuple100, 1024>(PartitionLayout::Pax, 50'000, 4);
+}
+
+TEST(ContiguousPartitionManagerTest, PaxColumnsAreContiguous) {
+    ContiguousPartitionManager<Tuple16, 2> partition_manager(1, PartitionLayout::Pax);
+    const std::vector<Tuple16> tuples{Tuple16(0, {1, 2, 3}), Tuple16(2, {4, 5, 6}), Tuple16(4, {7, 8, 9})};
+    const auto first_index = partition_manager.add_histogram_chunk({3, 0});
+    partition_manager.write_tuples(0, first_index[0], tuples.data(), tuples.size());
+
+    ASSERT_EQ(partition_manager.get_written_tuples_per_partition(), (std::vector<size_t>{3, 0}));
+    const auto keys = partition_manager.get_keys(0);
+    ASSERT_EQ(std::vector(keys.begin(), keys.end()), (std::vector<uint32_t>{0, 2, 4}));
+    std::array<uint32_t, 9> variable_data;
+    std::memcpy(variable_data.data(), partition_manager.get_variable_data(0), sizeof(variable_data));
+    ASSERT_EQ(variable_data, (std::array<uint32_t, 9>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(ContiguousPartitionManagerTest, OrchestratorRunsRepeatedly) {
+    constexpr size_t num_tuples = 100'003;
+    constexpr size_t partitions = 32;
+    RadixContiguousOrchestrator<Tuple16, partitions> orchestrator(GeneratedRelation<Tuple16>(num_tuples, KeyDistribution::sequential()), 3);
+    for (unsigned round = 0; round < 2; ++round) {
+        orchestrator.run();
+        auto &partition_manager = orchestrator.get_partition_manager();
+        std::vector<bool> seen(num_tuples, false);
+        for (size_t partition = 0; partition < partitions; ++partition) {
+            for (const auto &tuple: partition_manager.get_rows(partition)) {
+                ASSERT_EQ(tuple.get_key() % partitions, partition);
+                ASSERT_FALSE(seen[tuple.get_key()]);
+                seen[tuple.get_key()] = true;
+            }
+        }
+        ASSERT_EQ(std::ranges::count(seen, true), num_tuples);
+    }
+}
@@ -0,0 +1,96 @@
+#include "shuffle-operator/AdaptiveShuffleOrchestrator.hpp"
+#include "tuple-types/tuple-types.hpp"
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+TEST(ShuffleCostModelTest, PriorsFollowTheCalibrationRun) {
+    const ShuffleCostModel model;
+    for (const size_t tuple_size: {sizeof(Tuple4), sizeof(Tuple16), sizeof(Tuple100)}) {
+        ASSERT_EQ(model.rank({.tuple_size = tuple_size, .partitions = 32})[0], ShuffleAlgorithm::LocalPagesAndMerge);
+        ASSERT_EQ(model.rank({.tuple_size = tuple_size, .partitions = 32}).back(), ShuffleAlgorithm::Radix);
+    }
+    ASSERT_EQ(model.rank({.tuple_size = sizeof(Tuple16), .partitions = 4096}).back(), ShuffleAlgorithm::Hybrid);
+}
+
+TEST(ShuffleCostModelTest, HotPartitionsPenalizeSharedPages) {
+    const ShuffleCostModel model;
+    const ShuffleSample uniform{.tuple_size = sizeof(Tuple16), .partitions = 4096, .num_threads = 8};
+    ShuffleSample skewed = uniform;
+    skewed.skew = 8;
+    ASSERT_LT(model.estimate(ShuffleAlgorithm::Smb, uniform), model.estimate(ShuffleAlgorithm::Hybrid, uniform));
+    ASSERT_GT(model.estimate(ShuffleAlgorithm::Smb, skewed), model.estimate(ShuffleAlgorithm::Hybrid, skewed));
+}
+
+TEST(ShuffleCostModelTest, MeasurementsOverrideThePriors) {
+    ShuffleCostModel model;
+    const ShuffleSample sample{.tuple_size = sizeof(Tuple16), .partitions = 32};
+    const auto ranking = model.rank(sample);
+    model.observe(ranking[0], sample, 100 * ShuffleCostModel::get_prior(ranking[0], sample));
+    model.observe(ranking[1], sample, ShuffleCostModel::get_prior(ranking[1], sample));
+    ASSERT_TRUE(model.is_measured(ranking[0]));
+    ASSERT_EQ(model.rank(sample)[0], ranking[1]);
+}
+
+TEST(AdaptiveShuffleOrchestratorTest, MicroBatchesWriteAllTuples) {
+    constexpr size_t num_tuples = 50'000;
+    BasicAdaptiveShuffleOrchestrator<32> orchestrator({.tuple_layout = TupleLayout::Tuple16, .partitions = 32, .num_threads = 2}, 2);
+    for (unsigned batch = 0; batch < 4; ++batch) {
+        if (batch == 2) {
+            orchestrator.set_key_distribution(KeyDistribution::hot_key(0.5));
+        }
+        const auto written_tuples = orchestrator.run(num_tuples);
+        ASSERT_EQ(written_tuples.size(), 32);
+        ASSERT_EQ(std::accumulate(written_tuples.begin(), written_tuples.end(), size_t{0}), num_tuples);
+    }
+    ASSERT_GT(orchestrator.get_last_sample().skew, 8);
+}
+
+TEST(AdaptiveShuffleOrchestratorTest, SwitchesAlgorithmAfterAMeasurement) {
+    constexpr size_t num_tuples = 20'000;
+    BasicAdaptiveShuffleOrchestrator<32> orchestrator({.tuple_layout = TupleLayout::Tuple16, .partitions = 32}, 0);
+    orchestrator.run(num_tuples, 1);
+    const auto first_algorithm = orchestrator.get_last_algorithm();
+    const auto sample = orchestrator.get_last_sample();
+
+    // the runner-up turns out to be far cheaper than the batch that just ran
+    const auto expected_algorithm = orchestrator.get_cost_model().rank(sample)[1];
+    ASSERT_NE(expected_algorithm, first_algorithm);
+    const auto first_cost = orchestrator.get_cost_model().estimate(first_algorithm, sample);
+    orchestrator.get_cost_model().observe(expected_algorithm, sample, first_cost / 1000);
+    const auto written_tuples = orchestrator.run(num_tuples, 2);
+    ASSERT_EQ(orchestrator.get_last_algorithm(), expected_algorithm);
+    ASSERT_EQ(std::accumulate(written_tuples.begin(), written_tuples.end(), size_t{0}), num_tuples);
+}
+
+TEST(AdaptiveShuffleOrchestratorTest, CalibrateMeasuresEveryAlgorithm) {
+    BasicAdaptiveShuffleOrchestrator<32> orchestrator({.tuple_layout = TupleLayout::Tuple16, .partitions = 32});
+    orchestrator.calibrate(20'000);
+    for (const auto algorithm: orchestrator.get_cost_model().rank({})) {
+        ASSERT_TRUE(orchestrator.get_cost_model().is_measured(algorithm)) << get_shuffle_algorithm_name(algorithm);
+    }
+}
+
+TEST(AdaptiveShuffleOrchestratorTest, RuntimePathOnlyRunsAndCalibratesSmb) {
+    constexpr size_t num_tuples = 20'000;
+    BasicAdaptiveShuffleOrchestrator<32> orchestrator({.tuple_layout = TupleLayout::Tuple4, .partitions = 2048}, 2);
+    orchestrator.calibrate(num_tuples);
+    for (const auto algorithm: orchestrator.get_cost_model().rank({})) {
+        ASSERT_EQ(orchestrator.get_cost_model().is_measured(algorithm), algorithm == ShuffleAlgorithm::Smb) << get_shuffle_algorithm_name(algorithm);
+    }
+    // the second batch would explore the runner-up
+    for (unsigned batch = 0; batch < 2; ++batch) {
+        const auto written_tuples = orchestrator.run(num_tuples);
+        ASSERT_EQ(orchestrator.get_last_algorithm(), ShuffleAlgorithm::Smb);
+        ASSERT_EQ(std::accumulate(written_tuples.begin(), written_tuples.end(), size_t{0}), num_tuples);
+    }
+}
+
+TEST(AdaptiveShuffleOrchestratorTest, PrecompiledWideShuffleRunsTheCheapestAlgorithm) {
+    constexpr size_t num_tuples = 20'000;
+    BasicAdaptiveShuffleOrchestrator<2048> orchestrator({.tuple_layout = TupleLayout::Tuple4, .partitions = 2048}, 0);
+    const auto written_tuples = orchestrator.run(num_tuples, 1);
+    ASSERT_EQ(orchestrator.get_last_algorithm(), orchestrator.get_cost_model().rank(orchestrator.get_last_sample())[0]);
+    ASSERT_NE(orchestrator.get_last_algorithm(), ShuffleAlgorithm::Smb);
+    ASSERT_EQ(std::accumulate(written_tuples.begin(), written_tuples.end(), size_t{0}), num_tuples);
+}
@@ -0,0 +1,27 @@
+#include "shuffle-operator/ShuffleOperator.hpp"
+#include "tuple-types/tuple-types.hpp"
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+TEST(ShuffleOperatorTest, PrecompiledConfigurationRunsTheRequestedAlgorithm) {
+    const BasicShuffleOperator<32> shuffle_operator({.algorithm = ShuffleAlgorithm::Radix, .tuple_layout = TupleLayout::Tuple16, .partitions = 32, .num_threads = 2});
+    ASSERT_TRUE(shuffle_operator.uses_precompiled_path());
+    ASSERT_EQ(shuffle_operator.get_algorithm(), ShuffleAlgorithm::Radix);
+    const auto written_tuples = shuffle_operator.run(20'000, 1);
+    ASSERT_EQ(written_tuples.size(), 32);
+    ASSERT_EQ(std::accumulate(written_tuples.begin(), written_tuples.end(), size_t{0}), 20'000);
+}
+
+TEST(ShuffleOperatorTest, RuntimePathReportsSmb) {
+    for (const size_t partitions: {24, 2048}) {
+        const BasicShuffleOperator<32> shuffle_operator({.algorithm = ShuffleAlgorithm::Hybrid, .tuple_layout = TupleLayout::Tuple4, .partitions = partitions, .num_threads = 2});
+        ASSERT_FALSE(shuffle_operator.uses_precompiled_path());
+        ASSERT_EQ(shuffle_operator.get_algorithm(), ShuffleAlgorithm::Smb);
+        const auto written_tuples = shuffle_operator.run(20'000, 1);
+        ASSERT_EQ(written_tuples.size(), partitions);
+        ASSERT_EQ(std::accumulate(written_tuples.begin(), written_tuples.end(), size_t{0}), 20'000);
+    }
+    const BasicShuffleOperator<32> forced({.algorithm = ShuffleAlgorithm::Radix, .partitions = 32, .force_runtime_path = true});
+    ASSERT_EQ(forced.get_algorithm(), ShuffleAlgorithm::Smb);
+}
@@ -178,3 +178,30 @@ TEST(ManagedSlottedPageTest, FullPageInsertion) {
         ASSERT_EQ(read_tuple.value().get_variable_data(), (std::array{i + 1, i + 2, i + 3}));
     }
 }
+
+TEST(ManagedSlottedPageTest, StreamingBatchedInsertionTuple16) {
+    using tuple = Tuple16;
+    const auto page_size = 5 * 1024u;
+    const unsigned max_tuples = ManagedSlottedPage<tuple>::get_max_tuples(page_size);
+    std::unique_ptr<tuple[]> buffer(new tuple[max_tuples]);
+    for (unsigned i = 0; i < max_tuples; ++i) {
+        buffer[i] = tuple(i, {i + 1, i + 2, i + 3});
+    }
+
+    StreamingPageWriter::set_store(PageStore::Streaming);
+    ManagedSlottedPage<tuple> page(page_size);
+    // batch sizes that start and end inside cache lines
+    for (unsigned index = 0, batch_size = 1; index < max_tuples; index += batch_size, batch_size += 7) {
+        batch_size = std::min(batch_size, max_tuples - index);
+        page.add_tuple_batch_with_index(buffer.get() + index, index, batch_size);
+        page.increase_tuple_count(batch_size);
+    }
+    StreamingPageWriter::set_store(PageStore::Regular);
+
+    ASSERT_EQ(page.get_tuple_count(), max_tuples);
+    for (unsigned i = 0; i < max_tuples; ++i) {
+        auto read_tuple = page.get_tuple(i);
+        ASSERT_TRUE(read_tuple.has_value());
+        ASSERT_EQ(read_tuple.value().get_variable_data(), (std::array{i + 1, i + 2, i + 3}));
+    }
+}
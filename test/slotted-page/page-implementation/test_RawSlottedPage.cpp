@@ -129,3 +129,37 @@ TEST(RawSlottedPageTest, FullPageInsertion) {
         ASSERT_EQ(read_tuple.value().get_variable_data(), (std::array{i + 1, i + 2, i + 3}));
     }
 }
+
+void write_in_batches_and_check(const PageStore store) {
+    // large enough for batches above StreamingPageWriter::min_streaming_bytes
+    const auto page_size = 64 * 1024u;
+    RawSlottedPage<Tuple100> page(page_size);
+    const unsigned max_tuples = RawSlottedPage<Tuple100>::get_max_tuples(page_size);
+    std::vector<Tuple100> tuples;
+    for (unsigned i = 0; i < max_tuples; ++i) {
+        tuples.emplace_back(i, std::array<uint32_t, 24>{i + 1, i + 2});
+    }
+
+    StreamingPageWriter::set_store(store);
+    for (unsigned entry_num = 0, batch_size = 1; entry_num < max_tuples; entry_num += batch_size, batch_size += 5) {
+        batch_size = std::min(batch_size, max_tuples - entry_num);
+        RawSlottedPage<Tuple100>::write_tuple_batch(page.get_page_data(), page_size, tuples.data() + entry_num, entry_num, batch_size);
+    }
+    StreamingPageWriter::set_store(PageStore::Regular);
+    RawSlottedPage<Tuple100>::increase_tuple_count(page.get_page_data(), max_tuples);
+
+    ASSERT_EQ(page.get_tuple_count(), max_tuples);
+    for (unsigned i = 0; i < max_tuples; ++i) {
+        auto read_tuple = page.get_tuple(i);
+        ASSERT_TRUE(read_tuple.has_value());
+        ASSERT_EQ(read_tuple.value().get_variable_data(), (std::array<uint32_t, 24>{i + 1, i + 2}));
+    }
+}
+
+TEST(RawSlottedPageTest, BatchedInsertion) {
+    write_in_batches_and_check(PageStore::Regular);
+}
+
+TEST(RawSlottedPageTest, StreamingBatchedInsertion) {
+    write_in_batches_and_check(PageStore::Streaming);
+}
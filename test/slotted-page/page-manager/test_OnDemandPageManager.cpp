@@ -562,3 +562,41 @@ TEST(OnDemandPageManagerTest, BatchedInsertionWithBatchedWriteoutTuple100WithMul
         }
     }
 }
+
+TEST(OnDemandPageManagerTest, BatchedInsertionWithBatchedWriteoutTuple16NumaPlacements) {
+    constexpr unsigned page_size = 5 * 1024;
+    constexpr unsigned partitions = 32;
+
+    for (const auto placement: {NumaPlacement::None, NumaPlacement::HomeNode, NumaPlacement::PerNode}) {
+        OnDemandPageManager<Tuple16, partitions, page_size> page_manager(placement);
+        ASSERT_EQ(page_manager.get_numa_placement(), placement);
+
+        constexpr auto max_tuples_per_page = ManagedSlottedPage<Tuple16>::get_max_tuples(page_size);
+        const auto tuples_to_write_per_page = max_tuples_per_page + 32 - (max_tuples_per_page % 32);
+
+        std::unique_ptr<Tuple16[]> buffer(new Tuple16[32]);
+        for (unsigned i = 0; i < tuples_to_write_per_page * partitions; i += 32) {
+            for (unsigned j = 0; j < 32; ++j) {
+                buffer[j] = Tuple16(i + j, {i + j + 1, i + j + 2, i + j + 3});
+            }
+            page_manager.insert_buffer_of_tuples_batched(buffer.get(), 32, i / 32 % partitions);
+        }
+
+        const auto written_tuples = page_manager.get_written_tuples_per_partition();
+        for (unsigned i = 0; i < partitions; ++i) {
+            ASSERT_EQ(written_tuples[i], tuples_to_write_per_page);
+        }
+
+        const auto all_tuples = page_manager.get_all_tuples_per_partition();
+        for (unsigned i = 0; i < partitions; ++i) {
+            ASSERT_EQ(all_tuples[i].size(), tuples_to_write_per_page);
+            for (const auto &tuple: all_tuples[i]) {
+                ASSERT_EQ(tuple.get_key() / 32 % partitions, i);
+                ASSERT_EQ(tuple.get_variable_data(), (std::array{tuple.get_key() + 1, tuple.get_key() + 2, tuple.get_key() + 3}));
+            }
+        }
+
+        page_manager.release_partition(0);
+        ASSERT_EQ(page_manager.get_written_tuples_per_partition()[0], 0);
+    }
+}
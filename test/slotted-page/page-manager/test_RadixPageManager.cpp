@@ -0,0 +1,120 @@
+#include "radix/worker/process_radix_chunk.hpp"
+#include "radix/worker/process_radix_chunk_two_pass.hpp"
+#include "slotted-page/page-manager/RadixPageManager.hpp"
+#include "tuple-types/tuple-types.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(RadixPageManagerTest, ChunksShareThePartiallyFilledPage) {
+    constexpr unsigned page_size = 5 * 1024;
+    constexpr unsigned partitions = 1;
+    RadixPageManager<Tuple16, partitions, page_size> page_manager(2);
+    const unsigned tuples_per_page = RawSlottedPage<Tuple16>::get_max_tuples(page_size);
+    const unsigned first_chunk = tuples_per_page / 2;
+
+    const auto first_info = page_manager.add_histogram_chunk({first_chunk});
+    ASSERT_EQ(first_info[0].size(), 1);
+    ASSERT_EQ(first_info[0][0].start_num, 0);
+
+    // the second chunk needs a new page, but starts in the free part of the first one
+    const auto second_info = page_manager.add_histogram_chunk({tuples_per_page});
+    ASSERT_EQ(second_info[0].size(), 2);
+    ASSERT_EQ(second_info[0][0].page_data, first_info[0][0].page_data);
+    ASSERT_EQ(second_info[0][0].start_num, first_chunk);
+    ASSERT_EQ(second_info[0][0].tuples_to_write, tuples_per_page - first_chunk);
+    ASSERT_NE(second_info[0][1].page_data, first_info[0][0].page_data);
+    ASSERT_EQ(second_info[0][1].start_num, 0);
+    ASSERT_EQ(second_info[0][1].tuples_to_write, first_chunk);
+}
+
+template<size_t partitions, typename ProcessChunk>
+void shuffle_in_chunks_and_check(const unsigned num_tuples, const unsigned num_chunks, ProcessChunk process_chunk, const HistogramMerge merge = HistogramMerge::Locking) {
+    constexpr unsigned page_size = 5 * 1024;
+    RadixPageManager<Tuple16, partitions, page_size> page_manager(num_chunks, NumaPlacement::None, merge);
+    std::vector<Tuple16> tuples;
+    for (unsigned i = 0; i < num_tuples; ++i) {
+        tuples.emplace_back(i, std::array{i + 1, i + 2, i + 3});
+    }
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned chunk = 0; chunk < num_chunks; ++chunk) {
+            const unsigned first = chunk * num_tuples / num_chunks;
+            threads.emplace_back([&, first, chunk] { process_chunk(page_manager, tuples.data() + first, (chunk + 1) * num_tuples / num_chunks - first); });
+        }
+    }
+
+    const auto all_tuples = page_manager.get_all_tuples_per_partition();
+    std::vector<bool> seen(num_tuples, false);
+    for (unsigned partition = 0; partition < partitions; ++partition) {
+        ASSERT_EQ(all_tuples[partition].size(), num_tuples / partitions + (partition < num_tuples % partitions));
+        for (const auto &tuple: all_tuples[partition]) {
+            const auto key = tuple.get_key();
+            ASSERT_EQ(key % partitions, partition);
+            ASSERT_EQ(tuple.get_variable_data(), (std::array{key + 1, key + 2, key + 3}));
+            ASSERT_FALSE(seen[key]);
+            seen[key] = true;
+        }
+    }
+}
+
+TEST(RadixPageManagerTest, SinglePassChunksTuple16) {
+    constexpr size_t partitions = 32;
+    shuffle_in_chunks_and_check<partitions>(10'000, 3, [](auto &page_manager, Tuple16 *chunk, const size_t chunk_size) {
+        process_radix_chunk<Tuple16, partitions, 5 * 1024>(page_manager, chunk, chunk_size, 3);
+    });
+}
+
+TEST(RadixPageManagerTest, TwoPassChunksTuple16) {
+    constexpr size_t partitions = 1000;
+    shuffle_in_chunks_and_check<partitions>(100'003, 3, [](auto &page_manager, Tuple16 *chunk, const size_t chunk_size) {
+        process_radix_chunk_two_pass<Tuple16, partitions, 5 * 1024>(page_manager, chunk, chunk_size);
+    });
+}
+
+TEST(RadixPageManagerTest, BarrierMergeTuple16) {
+    constexpr size_t partitions = 32;
+    shuffle_in_chunks_and_check<partitions>(10'000, 4, [](auto &page_manager, Tuple16 *chunk, const size_t chunk_size) {
+        process_radix_chunk<Tuple16, partitions, 5 * 1024>(page_manager, chunk, chunk_size, 4);
+    }, HistogramMerge::Barrier);
+}
+
+TEST(RadixPageManagerTest, BarrierMergeAcrossRounds) {
+    constexpr unsigned page_size = 5 * 1024;
+    constexpr unsigned partitions = 4;
+    constexpr unsigned num_threads = 3;
+    RadixPageManager<Tuple4, partitions, page_size> page_manager(num_threads, NumaPlacement::None, HistogramMerge::Barrier);
+    const unsigned tuples_per_page = RawSlottedPage<Tuple4>::get_max_tuples(page_size);
+
+    // every round hands each thread a range directly behind the ones of the round before
+    std::vector<std::vector<unsigned>> starts(num_threads);
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t] {
+                for (unsigned round = 0; round < 3; ++round) {
+                    const auto write_info = page_manager.add_histogram_chunk({tuples_per_page / 2, 0, 1, 0});
+                    EXPECT_EQ(write_info[1].size(), 0);
+                    starts[t].push_back(write_info[2][0].start_num);
+                    for (const auto &info: write_info[0]) {
+                        RawSlottedPage<Tuple4>::increase_tuple_count(info.page_data, info.tuples_to_write);
+                    }
+                    RawSlottedPage<Tuple4>::increase_tuple_count(write_info[2][0].page_data, 1);
+                }
+            });
+        }
+    }
+
+    const auto written_tuples = page_manager.get_written_tuples_per_partition();
+    ASSERT_EQ(written_tuples[0], 3 * num_threads * (tuples_per_page / 2));
+    ASSERT_EQ(written_tuples[1], 0);
+    ASSERT_EQ(written_tuples[2], 3 * num_threads);
+    std::vector<unsigned> all_starts;
+    for (const auto &thread_starts: starts) {
+        all_starts.insert(all_starts.end(), thread_starts.begin(), thread_starts.end());
+    }
+    std::ranges::sort(all_starts);
+    for (unsigned i = 0; i < all_starts.size(); ++i) {
+        ASSERT_EQ(all_starts[i], i);
+    }
+}
@@ -0,0 +1,63 @@
+#include "slotted-page/page-manager/RuntimeOnDemandPageManager.hpp"
+#include "tuple-types/tuple-types.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(RuntimeOnDemandPageManagerTest, BasicInsertionsTuple4) {
+    constexpr unsigned page_size = 5 * 1024;
+    constexpr unsigned partitions = 24;
+    RuntimeOnDemandPageManager<Tuple4> page_manager(partitions, page_size);
+
+    for (unsigned i = 0; i < 32 * partitions; ++i) {
+        Tuple4 tuple(i);
+        page_manager.insert_tuple(tuple, i % partitions);
+    }
+
+    const auto written_tuples = page_manager.get_written_tuples_per_partition();
+    ASSERT_EQ(written_tuples.size(), partitions);
+    for (unsigned i = 0; i < partitions; ++i) {
+        ASSERT_EQ(written_tuples[i], 32);
+    }
+
+    const auto all_tuples = page_manager.get_all_tuples_per_partition();
+    for (unsigned i = 0; i < partitions; ++i) {
+        ASSERT_EQ(all_tuples[i].size(), 32);
+        for (unsigned j = 0; j < 32; ++j) {
+            ASSERT_EQ(all_tuples[i][j].get_key(), i + j * partitions);
+        }
+    }
+}
+
+TEST(RuntimeOnDemandPageManagerTest, BatchedInsertionWithBatchedWriteoutTuple16WithMultiplePages) {
+    constexpr unsigned page_size = 5 * 1024;
+    constexpr unsigned partitions = 24;
+    RuntimeOnDemandPageManager<Tuple16> page_manager(partitions, page_size);
+
+    constexpr auto max_tuples_per_page = ManagedSlottedPage<Tuple16>::get_max_tuples(page_size);
+    const auto tuples_to_write_per_page = max_tuples_per_page + 32 - (max_tuples_per_page % 32);
+
+    std::unique_ptr<Tuple16[]> buffer(new Tuple16[32]);
+    for (unsigned i = 0; i < tuples_to_write_per_page * partitions; i += 32) {
+        for (unsigned j = 0; j < 32; ++j) {
+            buffer[j] = Tuple16(i + j, {i + j + 1, i + j + 2, i + j + 3});
+        }
+        page_manager.insert_buffer_of_tuples_batched(buffer.get(), 32, i / 32 % partitions);
+    }
+
+    const auto written_tuples = page_manager.get_written_tuples_per_partition();
+    for (unsigned i = 0; i < partitions; ++i) {
+        ASSERT_EQ(written_tuples[i], tuples_to_write_per_page);
+    }
+
+    const auto all_tuples = page_manager.get_all_tuples_per_partition();
+    for (unsigned i = 0; i < partitions; ++i) {
+        ASSERT_EQ(all_tuples[i].size(), tuples_to_write_per_page);
+        for (unsigned offset = 0; offset < tuples_to_write_per_page; offset += 32) {
+            for (unsigned j = 0; j < 32; ++j) {
+                const unsigned key = i * 32 + offset * partitions + j;
+                ASSERT_EQ(all_tuples[i][offset + j].get_key(), key);
+                ASSERT_EQ(all_tuples[i][offset + j].get_variable_data(), (std::array{key + 1, key + 2, key + 3}));
+            }
+        }
+    }
+}
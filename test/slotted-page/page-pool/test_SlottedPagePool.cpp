@@ -0,0 +1,96 @@
+#include "slotted-page/page-pool/SlottedPagePool.hpp"
+#include "util/worker-pool/WorkerPool.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(SlottedPagePoolTest, TrimReachesTheCachesOfOtherThreads) {
+    constexpr size_t page_bytes = 64 * 1024;
+    SlottedPagePool::trim();
+    std::barrier<> step(2);
+    size_t cached_before_trim = 0;
+    size_t cached_after_trim = 0;
+    {
+        std::jthread worker([&] {
+            PooledPageMemory in_use = SlottedPagePool::acquire(page_bytes);
+            {
+                std::vector<PooledPageMemory> pages;
+                for (unsigned i = 0; i < 4; ++i) {
+                    pages.emplace_back(SlottedPagePool::acquire(page_bytes));
+                }
+            }
+            cached_before_trim = SlottedPagePool::get_cached_bytes();
+            step.arrive_and_wait();
+            // trim() on the main thread
+            step.arrive_and_wait();
+            // handed out before the trim, so it is freed instead of cached
+            in_use.reset();
+            cached_after_trim = SlottedPagePool::get_cached_bytes();
+        });
+        step.arrive_and_wait();
+        SlottedPagePool::trim();
+        step.arrive_and_wait();
+    }
+    ASSERT_EQ(cached_before_trim, 4 * page_bytes);
+    ASSERT_EQ(cached_after_trim, 0);
+}
+
+TEST(SlottedPagePoolTest, SharedFreeListsStopAtTheLimit) {
+    constexpr size_t page_bytes = 64 * 1024;
+    const auto max_shared_bytes = SlottedPagePool::get_max_shared_bytes();
+    SlottedPagePool::trim();
+    SlottedPagePool::set_max_shared_bytes(4 * page_bytes);
+    // the thread hands its cache to the shared free lists when it exits
+    std::jthread([] {
+        std::vector<PooledPageMemory> pages;
+        for (unsigned i = 0; i < 16; ++i) {
+            pages.emplace_back(SlottedPagePool::acquire(page_bytes));
+        }
+    }).join();
+    ASSERT_EQ(SlottedPagePool::get_cached_bytes(), 4 * page_bytes);
+    SlottedPagePool::set_max_shared_bytes(page_bytes);
+    ASSERT_EQ(SlottedPagePool::get_cached_bytes(), page_bytes);
+    SlottedPagePool::set_max_shared_bytes(max_shared_bytes);
+    SlottedPagePool::trim();
+}
+
+TEST(SlottedPagePoolTest, IdleWorkersReleaseTheirCache) {
+    constexpr size_t page_bytes = 64 * 1024;
+    ASSERT_TRUE(WorkerPool::uses_persistent_workers());
+    SlottedPagePool::trim();
+    WorkerPool::run({-1}, [](size_t) {
+        std::vector<PooledPageMemory> pages;
+        for (unsigned i = 0; i < 4; ++i) {
+            pages.emplace_back(SlottedPagePool::acquire(page_bytes));
+        }
+    });
+    // in the shared free lists, not in the cache of the idle worker
+    ASSERT_EQ(SlottedPagePool::get_cached_bytes(), 4 * page_bytes);
+    SlottedPagePool::trim();
+}
+
+TEST(SlottedPagePoolTest, RecycledPagesFollowTheAllocationPolicy) {
+    constexpr size_t page_bytes = 64 * 1024;
+    SlottedPagePool::trim();
+    auto dirty_page = SlottedPagePool::acquire(page_bytes);
+    std::memset(dirty_page.get(), 0xFF, page_bytes);
+    const auto *dirty_memory = dirty_page.get();
+    dirty_page.reset();
+
+    PageAllocator::set_policy({.allocation = PageAllocation::Zeroed});
+    // the uninitialized page stays in its own free list
+    auto zeroed_page = SlottedPagePool::acquire(page_bytes);
+    ASSERT_NE(zeroed_page.get(), dirty_memory);
+    std::memset(zeroed_page.get(), 0xFF, page_bytes);
+    const auto *zeroed_memory = zeroed_page.get();
+    zeroed_page.reset();
+    const auto recycled_page = SlottedPagePool::acquire(page_bytes);
+    ASSERT_EQ(recycled_page.get(), zeroed_memory);
+    ASSERT_TRUE(std::all_of(recycled_page.get(), recycled_page.get() + page_bytes, [](const uint8_t byte) { return byte == 0; }));
+    PageAllocator::set_policy({});
+    SlottedPagePool::trim();
+}
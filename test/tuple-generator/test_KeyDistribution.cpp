@@ -0,0 +1,28 @@
+#include "tuple-generator/KeyDistribution.hpp"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+TEST(KeyDistributionTest, ZipfKeysStayInRangeAndFavourTheFirstRanks) {
+    constexpr uint64_t num_keys = 1000;
+    const auto distribution = KeyDistribution::zipf(0.99, num_keys);
+    std::mt19937_64 gen(42);
+    std::vector<size_t> histogram(num_keys, 0);
+    for (unsigned i = 0; i < 100'000; ++i) {
+        const auto key = distribution.get_key(gen(), i);
+        ASSERT_LT(key, num_keys);
+        ++histogram[key];
+    }
+    ASSERT_GT(histogram[0], histogram[1]);
+    ASSERT_GT(histogram[1], histogram[num_keys - 1]);
+}
+
+TEST(KeyDistributionDeathTest, ZipfAbortsOutsideOfTheSupportedThetas) {
+    testing::GTEST_FLAG(death_test_style) = "threadsafe";
+    ASSERT_DEATH(KeyDistribution::zipf(1), "Zipf needs 0 < theta < 1");
+    ASSERT_DEATH(KeyDistribution::zipf(1.5), "Zipf needs 0 < theta < 1");
+    ASSERT_DEATH(KeyDistribution::zipf(0), "Zipf needs 0 < theta < 1");
+    ASSERT_DEATH(KeyDistribution::zipf(0.5, 1), "Zipf needs 0 < theta < 1");
+}
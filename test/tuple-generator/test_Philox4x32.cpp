@@ -0,0 +1,75 @@
+#include "tuple-generator/Philox4x32.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+// Philox4x32-10 vectors of the Random123 distribution (kat_vectors). The counter words are (block, stream) and the key
+// words are the seed, both low word first.
+struct KnownAnswer {
+    std::array<uint32_t, 4> counter;
+    std::array<uint32_t, 2> key;
+    std::array<uint32_t, 4> expected;
+
+    [[nodiscard]] uint64_t get_block() const {
+        return counter[0] | static_cast<uint64_t>(counter[1]) << 32;
+    }
+
+    [[nodiscard]] uint64_t get_stream() const {
+        return counter[2] | static_cast<uint64_t>(counter[3]) << 32;
+    }
+
+    [[nodiscard]] uint64_t get_seed() const {
+        return key[0] | static_cast<uint64_t>(key[1]) << 32;
+    }
+};
+
+constexpr KnownAnswer known_answers[] = {
+        {{0x00000000, 0x00000000, 0x00000000, 0x00000000}, {0x00000000, 0x00000000}, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+        {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}, {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+        {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}, {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}},
+};
+
+// fill uses the AVX-512 path for 16 blocks, the AVX2 path for 8 and the scalar one for the rest, as far as they are
+// compiled in. The known block is placed so that the low counter word does not wrap within the group.
+std::array<uint32_t, 4> fill_known_block(const KnownAnswer &answer, const size_t num_blocks) {
+    const Philox4x32 rng(answer.get_seed());
+    const size_t position = std::min<size_t>(answer.counter[0], num_blocks - 1);
+    std::vector<uint32_t> words(4 * num_blocks);
+    rng.fill(words.data(), answer.get_block() - position, num_blocks, answer.get_stream());
+    std::array<uint32_t, 4> block;
+    std::memcpy(block.data(), words.data() + 4 * position, Philox4x32::block_size);
+    return block;
+}
+}// namespace
+
+TEST(Philox4x32Test, ScalarBlockMatchesKnownAnswers) {
+    for (const auto &answer: known_answers) {
+        EXPECT_EQ(Philox4x32(answer.get_seed()).generate_block(answer.get_block(), answer.get_stream()), answer.expected);
+    }
+}
+
+TEST(Philox4x32Test, FillMatchesKnownAnswers) {
+    for (const auto &answer: known_answers) {
+        EXPECT_EQ(fill_known_block(answer, 1), answer.expected) << "scalar";
+        EXPECT_EQ(fill_known_block(answer, 8), answer.expected) << "8 blocks";
+        EXPECT_EQ(fill_known_block(answer, 16), answer.expected) << "16 blocks";
+    }
+}
+
+TEST(Philox4x32Test, FillMatchesScalarBlocks) {
+    const Philox4x32 rng(42);
+    // 16 + 8 + 3 blocks run through every path, the second range wraps the low counter word
+    for (const uint64_t first_block: {uint64_t{0}, uint64_t{0xFFFFFFF3}}) {
+        constexpr size_t num_blocks = 27;
+        std::vector<uint32_t> words(4 * num_blocks);
+        rng.fill(words.data(), first_block, num_blocks, 7);
+        for (size_t i = 0; i < num_blocks; ++i) {
+            const auto block = rng.generate_block(first_block + i, 7);
+            EXPECT_TRUE(std::equal(block.begin(), block.end(), words.begin() + 4 * i)) << "block " << first_block + i;
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#include "tuple-source/GeneratedRelation.hpp"
+#include "tuple-types/tuple-types.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(GeneratedRelationTest, UnalignedSplitsGenerateEveryKeyOnce) {
+    constexpr size_t num_tuples = 100'003;
+    constexpr size_t num_splits = 7;
+    const GeneratedRelation<Tuple16> relation(num_tuples, KeyDistribution::sequential(), 42);
+    std::vector<unsigned> seen(num_tuples, 0);
+    for (size_t split = 0; split < num_splits; ++split) {
+        const size_t first = split * num_tuples / num_splits;
+        auto source = relation.create_source(first, (split + 1) * num_tuples / num_splits - first);
+        for (auto batch = source.next_batch(); !batch.empty(); batch = source.next_batch()) {
+            for (const auto &tuple: batch) {
+                ASSERT_LT(tuple.get_key(), num_tuples);
+                ++seen[tuple.get_key()];
+            }
+        }
+    }
+    for (size_t key = 0; key < num_tuples; ++key) {
+        ASSERT_EQ(seen[key], 1) << "key " << key;
+    }
+}
+
+TEST(GeneratedRelationTest, UnalignedSourceContinuesTheStream) {
+    constexpr size_t num_tuples = 10'000;
+    constexpr size_t first = 3'001;
+    const GeneratedRelation<Tuple16> relation(num_tuples, KeyDistribution::uniform(), 42);
+    std::vector<Tuple16> all(num_tuples);
+    ASSERT_EQ(relation.create_source(0, num_tuples).fill(all), num_tuples);
+
+    // fill and next_batch both start with the rest of the first, partial batch
+    auto source = relation.create_source(first, num_tuples - first);
+    std::vector<Tuple16> head(100);
+    ASSERT_EQ(source.fill(head), head.size());
+    std::vector<Tuple16> rest;
+    for (auto batch = source.next_batch(); !batch.empty(); batch = source.next_batch()) {
+        rest.insert(rest.end(), batch.begin(), batch.end());
+    }
+    ASSERT_EQ(head.size() + rest.size(), num_tuples - first);
+    for (size_t i = 0; i < head.size(); ++i) {
+        ASSERT_EQ(head[i].get_key(), all[first + i].get_key());
+        ASSERT_EQ(head[i].get_variable_data(), all[first + i].get_variable_data());
+    }
+    for (size_t i = 0; i < rest.size(); ++i) {
+        ASSERT_EQ(rest[i].get_key(), all[first + head.size() + i].get_key());
+        ASSERT_EQ(rest[i].get_variable_data(), all[first + head.size() + i].get_variable_data());
+    }
+}
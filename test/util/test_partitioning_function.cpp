@@ -0,0 +1,102 @@
+#include "tuple-types/tuple-types.hpp"
+#include "util/partition_hash.hpp"
+#include "util/partitioning_function.hpp"
+
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr uint32_t edge_keys[] = {0, 1, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFE, 0xFFFFFFFF};
+constexpr uint16_t untouched_id = 0xFFFF;
+
+// the payload differs from the key, so a gather with the wrong stride reads other values
+template<typename T>
+std::vector<T> make_tuples(const size_t count) {
+    std::mt19937 gen(42);
+    std::vector<T> tuples;
+    tuples.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t key = i < std::size(edge_keys) ? edge_keys[i] : static_cast<uint32_t>(gen());
+        if constexpr (sizeof(T) == sizeof(uint32_t)) {
+            tuples.emplace_back(key);
+        } else {
+            std::array<uint32_t, sizeof(T) / sizeof(uint32_t) - 1> payload;
+            payload.fill(~key);
+            tuples.emplace_back(key, payload);
+        }
+    }
+    return tuples;
+}
+
+// Every batch length from 0 to past two AVX-512 vectors, from an aligned and an unaligned first tuple, and one long
+// batch. The SIMD paths have to agree with the scalar partition_function and must not write past the batch.
+template<typename T, size_t partitions, typename PartitionHash>
+void expect_batches_match_scalar() {
+    SCOPED_TRACE(testing::Message() << sizeof(T) << " byte tuples, " << partitions << " partitions");
+    const auto tuples = make_tuples<T>(1000);
+    const RuntimePartitionFunction<PartitionHash> runtime_partition_function(partitions);
+    std::vector<size_t> counts;
+    for (size_t count = 0; count <= 40; ++count) {
+        counts.push_back(count);
+    }
+    counts.push_back(tuples.size() - 1);
+
+    std::vector<uint16_t> ids(tuples.size());
+    std::vector<uint16_t> runtime_ids(tuples.size());
+    for (const size_t offset: {size_t{0}, size_t{1}}) {
+        for (const size_t count: counts) {
+            std::ranges::fill(ids, untouched_id);
+            std::ranges::fill(runtime_ids, untouched_id);
+            partition_function_batch<T, partitions, PartitionHash>(tuples.data() + offset, count, ids.data());
+            runtime_partition_function(tuples.data() + offset, count, runtime_ids.data());
+            for (size_t i = 0; i < count; ++i) {
+                const auto &tuple = tuples[offset + i];
+                const size_t expected = partition_function<T, partitions, PartitionHash>(tuple);
+                ASSERT_EQ(expected, PartitionHash::hash(tuple.get_key()) % partitions) << "key " << tuple.get_key();
+                ASSERT_EQ(ids[i], expected) << "tuple " << i << " of " << count << " from " << offset;
+                ASSERT_EQ(runtime_ids[i], expected) << "tuple " << i << " of " << count << " from " << offset;
+            }
+            ASSERT_EQ(ids[count], untouched_id) << count << " tuples from " << offset;
+            ASSERT_EQ(runtime_ids[count], untouched_id) << count << " tuples from " << offset;
+        }
+    }
+}
+
+// powers of two use the mask, the others FastModulo
+template<typename T, typename PartitionHash>
+void expect_batches_match_scalar_for_partition_counts() {
+    expect_batches_match_scalar<T, 16, PartitionHash>();
+    expect_batches_match_scalar<T, 24, PartitionHash>();
+    expect_batches_match_scalar<T, 48, PartitionHash>();
+    expect_batches_match_scalar<T, 96, PartitionHash>();
+    expect_batches_match_scalar<T, 1000, PartitionHash>();
+    expect_batches_match_scalar<T, 1024, PartitionHash>();
+    expect_batches_match_scalar<T, 65536, PartitionHash>();
+}
+
+template<typename PartitionHash>
+void expect_batches_match_scalar_for_tuple_types() {
+    expect_batches_match_scalar_for_partition_counts<Tuple4, PartitionHash>();
+    expect_batches_match_scalar_for_partition_counts<Tuple16, PartitionHash>();
+    expect_batches_match_scalar_for_partition_counts<Tuple100, PartitionHash>();
+}
+}// namespace
+
+TEST(PartitionFunctionBatchTest, IdentityHashMatchesScalar) {
+    expect_batches_match_scalar_for_tuple_types<IdentityHash>();
+}
+
+TEST(PartitionFunctionBatchTest, Crc32HashMatchesScalar) {
+    expect_batches_match_scalar_for_tuple_types<Crc32Hash>();
+}
+
+TEST(PartitionFunctionBatchTest, FibonacciHashMatchesScalar) {
+    expect_batches_match_scalar_for_tuple_types<FibonacciHash>();
+}
+
+TEST(PartitionFunctionBatchTest, MurmurHashMatchesScalar) {
+    expect_batches_match_scalar_for_tuple_types<MurmurHash>();
+}